@@ -0,0 +1,64 @@
+/**
+ * @file affinity.h
+ * @brief Header file for pinning cpus and threads to cores
+ */
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <stdio.h>
+
+/**
+ * @brief Policies to bind cpus and their OMP threads to cores
+ */
+typedef enum {
+    AFFINITY_NONE = 0, // left to the OS and to mpiexec
+    AFFINITY_COMPACT = 1, // one physical core each, SMT siblings left idle, filling a socket before the next
+    AFFINITY_SCATTER = 2, // one physical core each, SMT siblings left idle, alternating sockets
+    AFFINITY_SOCKET = 3, // each cpu bound to a whole socket, its threads free within it
+    N_AFFINITIES
+} affinity_t;
+
+/**
+ * @brief Convert affinity_t to string
+ *
+ * @param affinity affinity policy
+ * @return const char*
+ */
+const char* affinity2str(affinity_t affinity);
+
+
+/**
+ * @brief Read the affinity policy from the PARCO_AFFINITY environment variable (none, compact, scatter, socket)
+ *
+ * @return affinity_t policy, AFFINITY_NONE if not set or not recognized
+ */
+affinity_t get_affinity();
+
+
+/**
+ * @brief Bind the calling cpu and its team of OMP threads to cores, collectively on all cpus
+ *
+ * The physical cores of a node are split in equal blocks among the cpus sharing it, and with COMPACT or
+ * SCATTER each thread gets its own physical core inside the block of its cpu. If there are fewer physical
+ * cores than threads on the node, those policies fall back to SOCKET. The whole team of omp_get_max_threads() threads is pinned,
+ * so the number of threads should not change afterwards. Run mpiexec with --bind-to none so that each
+ * cpu can see all the cores of its node.
+ *
+ * @param affinity affinity policy
+ */
+void set_affinity(affinity_t affinity);
+
+
+/**
+ * @brief Print the cores each thread of each cpu is bound to, with their sockets and NUMA nodes, collectively on all cpus
+ *
+ * The binding is the affinity mask of the thread, not the core it happens to run on.
+ * Only rank 0 writes, one line per thread starting with '#'.
+ *
+ * @param log log file
+ */
+void print_affinity(FILE* log);
+
+
+#endif // AFFINITY_H
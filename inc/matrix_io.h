@@ -0,0 +1,108 @@
+/**
+ * @file matrix_io.h
+ * @brief Header file for matrix file I/O
+ */
+
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAT_FILE_MAGIC 0x54414D50 // "PMAT" in little endian
+
+/**
+ * @brief Header of a binary matrix file, followed by rows * cols raw elements in row-major order
+ */
+typedef struct {
+    uint32_t magic;
+    int32_t rows;
+    int32_t cols;
+    int32_t elem_size;
+} mat_header_t;
+
+
+/**
+ * @brief Check the header of a binary matrix file
+ *
+ * @param header header read from the file
+ * @return true if the header describes a non-empty float matrix, false otherwise
+ */
+bool valid_mat_header(const mat_header_t* header);
+
+
+// SEQUENTIAL
+/**
+ * @brief Write a matrix to a binary matrix file
+ *
+ * @param path file path
+ * @param M matrix
+ * @param rows number of rows of M
+ * @param cols number of columns of M
+ * @return true if the matrix has been written, false otherwise
+ */
+bool write_mat_file(const char* path, float* M, int rows, int cols);
+
+
+/**
+ * @brief Read a matrix from a binary matrix file
+ *
+ * @param[in] path file path
+ * @param[out] rows number of rows of the matrix read
+ * @param[out] cols number of columns of the matrix read
+ * @return float* newly allocated matrix, NULL on error
+ */
+float* read_mat_file(const char* path, int* rows, int* cols);
+
+
+// MPI-IO
+/**
+ * @brief Read the header of a binary matrix file, collectively on all cpus
+ *
+ * @param[in] fh file opened on MPI_COMM_WORLD
+ * @param[out] header header read from the file
+ * @return true if the header is valid for a float matrix, false otherwise
+ */
+bool read_mat_header_MPI(MPI_File fh, mat_header_t* header);
+
+
+/**
+ * @brief Read the band of columns owned by this cpu, collectively on all cpus
+ *
+ * Each cpu reads mat_size / n_cpus columns, the first mat_size % n_cpus cpus one more.
+ *
+ * @param[in] fh file opened on MPI_COMM_WORLD
+ * @param[out] local_M local band of columns, M[mat_size][chunk_size]
+ * @param[in] mat_size size of the stored matrix M[n][n], at least n_cpus
+ * @return true if every cpu has read its whole band, false if the file is truncated
+ */
+bool matReadColsMPI(MPI_File fh, float* local_M, int mat_size, int rank, int n_cpus);
+
+
+/**
+ * @brief Write the band of rows owned by this cpu, collectively on all cpus
+ *
+ * Each cpu writes mat_size / n_cpus rows, the first mat_size % n_cpus cpus one more.
+ *
+ * @param[in] fh file opened on MPI_COMM_WORLD
+ * @param[in] local_T local band of rows, T[chunk_size][mat_size]
+ * @param[in] mat_size size of the stored matrix T[n][n], at least n_cpus
+ */
+void matWriteRowsMPI(MPI_File fh, float* local_T, int mat_size, int rank, int n_cpus);
+
+
+/**
+ * @brief Transpose a matrix stored in a file into another file, parallelized using MPI-IO
+ *
+ * No cpu ever holds the whole matrix: each one reads its band of columns of M and writes its band of rows of T.
+ * The matrix size need not be a multiple of the number of cpus.
+ *
+ * @param in_path file containing M
+ * @param out_path file where T will be written
+ * @return true if the transposition has been written, false otherwise
+ */
+bool matTransposeFileMPI(const char* in_path, const char* out_path, int rank, int n_cpus);
+
+
+#endif // MATRIX_IO_H
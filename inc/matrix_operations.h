@@ -7,9 +7,16 @@
 #define MATRIX_OPERATIONS_H
 
 #include <mpi.h>
+#include <stddef.h>
 #include <stdbool.h>
 
 
+/**
+ * @brief Pointer to element [i][j] of a matrix with leading dimension ld, i.e. a view of the sub-matrix starting there
+ */
+#define MAT_VIEW(M, ld, i, j) ((M) + (size_t)(i) * (ld) + (j))
+
+
 // TASK 1
 /**
  * @brief Check if a matrix is symmetric
@@ -53,6 +60,19 @@ void matTransposeMPI(float* M, float* T, int mat_size, int rank, int n_cpus);
 
 void matTransposeMPI_Bcast(float* M, float* T, int mat_size, int rank, int n_cpus);
 
+/**
+ * @brief Transpose a given matrix, parallelized using MPI, with the transposition expressed in the datatypes
+ * 
+ * Row bands of M are scattered as they are and gathered into column bands of T,
+ * so the MPI library reorders the elements and no local transposition is needed.
+ * mat_size need not be a multiple of n_cpus, the first mat_size % n_cpus cpus get one more row.
+ * 
+ * @param[in] M matrix
+ * @param[in] mat_size size of matrix M[n][n]
+ * @param[out] T result of the transposition
+ */
+void matTransposeMPI_Datatype(float* M, float* T, int mat_size, int rank, int n_cpus);
+
 // TASK 4
 /**
  * @brief Check if a matrix is symmetric, parallelized using OMP
@@ -74,6 +94,117 @@ bool checkSymOMP(float* M, int n);
 void matTransposeOMP(float* M, float* T, int n);
 
 
+// STRIDED
+/**
+ * @brief Check if a square sub-matrix is symmetric, without logging
+ * 
+ * @param M first element of the sub-matrix (see MAT_VIEW)
+ * @param lda leading dimension of M, distance between the starts of two rows
+ * @param n size of the sub-matrix
+ * @return true if the sub-matrix is symmetric, false otherwise
+ */
+bool checkSymLd(float* M, int lda, int n);
+
+
+/**
+ * @brief Transpose a sub-matrix into another one, without logging
+ * 
+ * M and T must not overlap, not even as the same square panel: the transposition is not in place.
+ * 
+ * @param[in] M first element of the sub-matrix M[rows][cols] (see MAT_VIEW)
+ * @param[in] lda leading dimension of M
+ * @param[out] T first element of the sub-matrix T[cols][rows]
+ * @param[in] ldt leading dimension of T
+ * @param[in] rows rows of M
+ * @param[in] cols columns of M
+ */
+void matTransposeLd(float* M, int lda, float* T, int ldt, int rows, int cols);
+
+
+/**
+ * @brief Check if a square sub-matrix is symmetric, parallelized using OMP, without logging
+ * 
+ * @param M first element of the sub-matrix (see MAT_VIEW)
+ * @param lda leading dimension of M
+ * @param n size of the sub-matrix
+ * @return true if the sub-matrix is symmetric, false otherwise
+ */
+bool checkSymOMPLd(float* M, int lda, int n);
+
+
+/**
+ * @brief Transpose a sub-matrix into another one, parallelized using OMP, without logging
+ * 
+ * M and T must not overlap, not even as the same square panel: the transposition is not in place.
+ * 
+ * @param[in] M first element of the sub-matrix M[rows][cols] (see MAT_VIEW)
+ * @param[in] lda leading dimension of M
+ * @param[out] T first element of the sub-matrix T[cols][rows]
+ * @param[in] ldt leading dimension of T
+ * @param[in] rows rows of M
+ * @param[in] cols columns of M
+ */
+void matTransposeOMPLd(float* M, int lda, float* T, int ldt, int rows, int cols);
+
+
+// BATCH
+/**
+ * @brief Transpose a batch of matrices stored back to back, parallelized across the batch using OMP
+ * 
+ * @param[in] M batch of matrices, M[batch][n][n]
+ * @param[in] n size of each matrix
+ * @param[in] batch number of matrices
+ * @param[out] T result of the transpositions, T[batch][n][n]
+ */
+void matTransposeBatchOMP(float* M, float* T, int n, int batch);
+
+
+/**
+ * @brief Transpose a batch of separately allocated matrices, parallelized across the batch using OMP
+ * 
+ * @param[in] M array of batch matrices M[n][n]
+ * @param[in] n size of each matrix
+ * @param[in] batch number of matrices
+ * @param[out] T array of batch matrices receiving the transpositions
+ */
+void matTransposeBatchPtrOMP(float** M, float** T, int n, int batch);
+
+
+/**
+ * @brief Check if each matrix of a batch stored back to back is symmetric, parallelized across the batch using OMP
+ * 
+ * @param[in] M batch of matrices, M[batch][n][n]
+ * @param[in] n size of each matrix
+ * @param[in] batch number of matrices
+ * @param[out] isSym isSym[b] is true if matrix b is symmetric
+ * @return true if all the matrices are symmetric, false otherwise
+ */
+bool checkSymBatchOMP(float* M, bool* isSym, int n, int batch);
+
+
+/**
+ * @brief Transpose a batch of matrices stored back to back, distributing the matrices across cpus using MPI
+ * 
+ * @param[in] M batch of matrices, M[batch][n][n], only significant on rank 0
+ * @param[in] n size of each matrix
+ * @param[in] batch number of matrices
+ * @param[out] T result of the transpositions, T[batch][n][n], only significant on rank 0
+ */
+void matTransposeBatchMPI(float* M, float* T, int n, int batch, int rank, int n_cpus);
+
+
+/**
+ * @brief Check if each matrix of a batch stored back to back is symmetric, distributing the matrices across cpus using MPI
+ * 
+ * @param[in] M batch of matrices, M[batch][n][n], only significant on rank 0
+ * @param[in] n size of each matrix
+ * @param[in] batch number of matrices
+ * @param[out] isSym isSym[b] is true if matrix b is symmetric, only significant on rank 0
+ * @return true if all the matrices are symmetric, false otherwise, on all cpus
+ */
+bool checkSymBatchMPI(float* M, bool* isSym, int n, int batch, int rank, int n_cpus);
+
+
 // TEST
 /**
  * @brief Check if transposition return the correct result
@@ -86,4 +217,16 @@ void matTransposeOMP(float* M, float* T, int n);
 bool check_transpose(float* M, float* T, int size);
 
 
+/**
+ * @brief Check if the transposition of a batch of matrices stored back to back returned the correct result
+ * 
+ * @param M batch of matrices
+ * @param T batch of transpositions
+ * @param size size of each matrix
+ * @param batch number of matrices
+ * @return true if they've all been transposed correctly, false otherwise
+ */
+bool check_transpose_batch(float* M, float* T, int size, int batch);
+
+
 #endif // MATRIX_OPERATIONS_H
\ No newline at end of file
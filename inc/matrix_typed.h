@@ -0,0 +1,80 @@
+/**
+ * @file matrix_typed.h
+ * @brief Header file for matrix operations specialised on the element type
+ */
+
+#ifndef MATRIX_TYPED_H
+#define MATRIX_TYPED_H
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAT_TILE_BYTES 128 // bytes in a tile row, tiles are MAT_TILE_BYTES / sizeof(type) elements wide
+
+/**
+ * @brief bfloat16 element, stored as its raw bits (upper half of a float)
+ */
+typedef uint16_t bf16_t;
+
+/**
+ * @brief Supported element types: X(type, suffix, MPI datatype, name)
+ */
+#define MAT_ELEM_TYPES(X) \
+    X(float,   f32,  MPI_FLOAT,    "FLOAT")    \
+    X(double,  f64,  MPI_DOUBLE,   "DOUBLE")   \
+    X(int32_t, i32,  MPI_INT32_T,  "INT32")    \
+    X(int16_t, i16,  MPI_INT16_T,  "INT16")    \
+    X(bf16_t,  bf16, MPI_UINT16_T, "BFLOAT16")
+
+/**
+ * @brief Element types that can be tested
+ */
+typedef enum {
+#define X(type, sfx, mpi_type, name) ELEM_##sfx,
+    MAT_ELEM_TYPES(X)
+#undef X
+    N_ELEM_TYPES
+} elem_t;
+
+/**
+ * @brief Convert elem_t to string
+ *
+ * @param elem element type
+ * @return const char*
+ */
+const char* elem2str(elem_t elem);
+
+
+/**
+ * @brief Declare the operations specialised on one element type, e.g. for double:
+ *
+ * - double* new_mat_f64(int rows, int cols): allocate a matrix
+ * - void free_mat_f64(double* M): free a matrix
+ * - void init_mat_f64(double* M, int n): populate M[n][n] with random values
+ * - void init_symmetric_mat_f64(double* M, int n): populate M[n][n] with random values, symmetric
+ * - bool checkSym_f64(double* M, int n): check if M[n][n] is symmetric
+ * - bool checkSymOMP_f64(double* M, int n): same as above, parallelized using OMP
+ * - void matTranspose_f64(double* M, double* T, int n): transpose M[n][n] into T, tile by tile
+ * - void matTransposeOMP_f64(double* M, double* T, int n): same as above, parallelized using OMP
+ * - void matTransposeMPI_f64(double* M, double* T, int n, int rank, int n_cpus): same as matTransposeMPI, n need not be a multiple of n_cpus
+ * - bool check_transpose_f64(double* M, double* T, int n): check if T is the transposition of M
+ *
+ * Elements are compared bitwise, so bfloat16 is handled as its raw bits.
+ */
+#define DECLARE_TYPED_OPERATIONS(type, sfx, mpi_type, name) \
+    type* new_mat_##sfx(int rows, int cols); \
+    void free_mat_##sfx(type* M); \
+    void init_mat_##sfx(type* M, int n); \
+    void init_symmetric_mat_##sfx(type* M, int n); \
+    bool checkSym_##sfx(type* M, int n); \
+    bool checkSymOMP_##sfx(type* M, int n); \
+    void matTranspose_##sfx(type* M, type* T, int n); \
+    void matTransposeOMP_##sfx(type* M, type* T, int n); \
+    void matTransposeMPI_##sfx(type* M, type* T, int n, int rank, int n_cpus); \
+    bool check_transpose_##sfx(type* M, type* T, int n);
+
+MAT_ELEM_TYPES(DECLARE_TYPED_OPERATIONS)
+
+
+#endif // MATRIX_TYPED_H
@@ -0,0 +1,30 @@
+/**
+ * @file out_of_core.h
+ * @brief Header file for out-of-core matrix operations
+ */
+
+#ifndef OUT_OF_CORE_H
+#define OUT_OF_CORE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define OOC_TILE 64 // side of the square tiles transposed by each thread
+
+
+/**
+ * @brief Transpose a matrix stored in a file into another file, without loading it in memory
+ *
+ * Both files are memory-mapped and M is processed in panels of rows, sized so that a panel of M
+ * and the strip of T it produces fit in mem_budget bytes. Each panel is transposed in parallel using OMP,
+ * then writeback of the pages of T it completed is started and they are released, together with the panel.
+ *
+ * @param in_path binary matrix file containing M (see matrix_io.h)
+ * @param out_path binary matrix file where T will be written
+ * @param mem_budget bytes of memory available to resident panels
+ * @return true if the transposition has been written, false otherwise
+ */
+bool matTransposeOOC(const char* in_path, const char* out_path, size_t mem_budget);
+
+
+#endif // OUT_OF_CORE_H
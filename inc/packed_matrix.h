@@ -0,0 +1,93 @@
+/**
+ * @file packed_matrix.h
+ * @brief Header file for symmetric matrices in packed storage
+ */
+
+#ifndef PACKED_MATRIX_H
+#define PACKED_MATRIX_H
+
+#include <stddef.h>
+
+
+/**
+ * @brief Number of elements of a packed symmetric matrix, its upper triangle
+ *
+ * @param n size of the unpacked matrix M[n][n]
+ * @return size_t n * (n + 1) / 2
+ */
+static inline size_t packed_size(int n) {
+    return (size_t)n * (n + 1) / 2;
+}
+
+
+/**
+ * @brief Position of M[i][j] in the packed upper triangle, stored row by row
+ *
+ * @param i row, i <= j
+ * @param j column
+ * @param n size of the unpacked matrix M[n][n]
+ * @return size_t index in the packed matrix
+ */
+static inline size_t packed_index(int i, int j, int n) {
+    return (size_t)i * n - (size_t)i * (i - 1) / 2 + (j - i);
+}
+
+
+/**
+ * @brief Allocate a packed symmetric matrix
+ *
+ * @param n size of the unpacked matrix M[n][n]
+ * @return float* packed matrix P[n * (n + 1) / 2]
+ */
+float* new_packed_mat(int n);
+
+
+/**
+ * @brief Pack the upper triangle of a symmetric matrix, parallelized using OMP
+ *
+ * @param[in] M symmetric matrix M[n][n]
+ * @param[out] P packed matrix
+ * @param[in] n size of matrix M[n][n]
+ */
+void packSymOMP(float* M, float* P, int n);
+
+
+/**
+ * @brief Unpack a packed symmetric matrix into both triangles, parallelized using OMP
+ *
+ * @param[in] P packed matrix
+ * @param[out] M symmetric matrix M[n][n]
+ * @param[in] n size of matrix M[n][n]
+ */
+void unpackSymOMP(float* P, float* M, int n);
+
+
+/**
+ * @brief Transpose a packed symmetric matrix
+ *
+ * A symmetric matrix is its own transposition, and its packed upper triangle stored by rows is
+ * also the packed lower triangle stored by columns: this is a no-op if P and PT are the same, a copy otherwise.
+ *
+ * @param[in] P packed matrix
+ * @param[out] PT packed transposition
+ * @param[in] n size of the unpacked matrix M[n][n]
+ */
+void matTransposePacked(float* P, float* PT, int n);
+
+
+/**
+ * @brief Transpose a packed symmetric matrix into a dense one, parallelized using MPI
+ *
+ * Only the packed matrix is broadcast, half of what matTransposeMPI_Bcast sends,
+ * then each cpu unpacks its band of rows of T, the first n % n_cpus cpus one row more.
+ * Packed bands are not scattered instead, since a band of rows of T needs elements
+ * from every packed row above it.
+ *
+ * @param[in] P packed matrix
+ * @param[out] T result of the transposition T[n][n]
+ * @param[in] n size of the unpacked matrix M[n][n]
+ */
+void matTransposePackedMPI_Bcast(float* P, float* T, int n, int rank, int n_cpus);
+
+
+#endif // PACKED_MATRIX_H
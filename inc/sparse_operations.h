@@ -0,0 +1,145 @@
+/**
+ * @file sparse_operations.h
+ * @brief Header file for sparse matrix operations
+ */
+
+#ifndef SPARSE_OPERATIONS_H
+#define SPARSE_OPERATIONS_H
+
+#include <mpi.h>
+#include <stdbool.h>
+
+/**
+ * @brief Sparse matrix in Compressed Sparse Row format
+ *
+ * Nonzeros of row i are col_idx[row_ptr[i]..row_ptr[i + 1]) and val[row_ptr[i]..row_ptr[i + 1]),
+ * with increasing column indices within each row.
+ */
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int* row_ptr;
+    int* col_idx;
+    float* val;
+} csr_t;
+
+
+// MATRIX
+/**
+ * @brief Allocate a CSR matrix
+ *
+ * @param rows number of rows
+ * @param cols number of columns
+ * @param nnz number of nonzeros
+ * @return csr_t*
+ */
+csr_t* new_csr(int rows, int cols, int nnz);
+
+
+/**
+ * @brief Free a previously allocated CSR matrix
+ *
+ * @param A CSR matrix
+ */
+void free_csr(csr_t* A);
+
+
+/**
+ * @brief Initialize given matrix, populating it with random values at random positions
+ *
+ * @param M matrix
+ * @param n size of matrix M[n][n]
+ * @param density probability of an element being nonzero
+ */
+void init_sparse_mat(float* M, int n, float density);
+
+
+/**
+ * @brief Initialize given matrix, populating it with random values at random positions to make it symmetric
+ *
+ * @param M matrix
+ * @param n size of matrix M[n][n]
+ * @param density probability of an element being nonzero
+ */
+void init_symmetric_sparse_mat(float* M, int n, float density);
+
+
+/**
+ * @brief Convert a dense matrix to CSR
+ *
+ * @param M matrix
+ * @param n size of matrix M[n][n]
+ * @return csr_t* CSR matrix holding the nonzeros of M
+ */
+csr_t* dense2csr(float* M, int n);
+
+
+/**
+ * @brief Convert a CSR matrix to dense
+ *
+ * @param[in] A CSR matrix
+ * @param[out] M matrix M[rows][cols]
+ */
+void csr2dense(csr_t* A, float* M);
+
+
+/**
+ * @brief Convert a matrix in COOrdinate format, with entries in any order, to CSR
+ *
+ * @param rows number of rows
+ * @param cols number of columns
+ * @param nnz number of entries
+ * @param row_idx row of each entry
+ * @param col_idx column of each entry
+ * @param val value of each entry
+ * @return csr_t* CSR matrix
+ */
+csr_t* coo2csr(int rows, int cols, int nnz, int* row_idx, int* col_idx, float* val);
+
+
+// TRANSPOSITION
+/**
+ * @brief Transpose a CSR matrix, counting the nonzeros of each column and placing them after a prefix sum
+ *
+ * @param A CSR matrix
+ * @return csr_t* transposition of A
+ */
+csr_t* csrTranspose(csr_t* A);
+
+
+/**
+ * @brief Transpose a CSR matrix, parallelized using OMP
+ *
+ * Each thread counts the nonzeros of each column in its band of rows, so that after a prefix sum
+ * over columns and threads every thread knows where to place its nonzeros without synchronization.
+ *
+ * @param A CSR matrix
+ * @return csr_t* transposition of A
+ */
+csr_t* csrTransposeOMP(csr_t* A);
+
+
+/**
+ * @brief Transpose a CSR matrix, parallelized using MPI
+ *
+ * Bands of rows are scattered, each cpu transposes its band, and rank 0 merges the bands of columns.
+ *
+ * @param A CSR matrix, only significant on rank 0
+ * @return csr_t* transposition of A on rank 0, NULL on the other cpus
+ */
+csr_t* csrTransposeMPI(csr_t* A, int rank, int n_cpus);
+
+
+// SYMMETRY
+/**
+ * @brief Check if a CSR matrix is symmetric, parallelized using OMP
+ *
+ * @param[in] A square CSR matrix
+ * @param[out] structural true if the nonzeros are in symmetric positions, whatever their values
+ * @return true if the matrix is symmetric, false otherwise
+ */
+bool csrCheckSymOMP(csr_t* A, bool* structural);
+
+
+#endif // SPARSE_OPERATIONS_H
@@ -12,4 +12,46 @@
  */
 void test_performance(int rank, int size);
 
+/**
+ * @brief Benchmark the transposition of matrices stored in files, using MPI-IO
+ * 
+ */
+void test_file_io(int rank, int size);
+
+/**
+ * @brief Benchmark the out-of-core transposition of matrices stored in files, with a budget smaller than the matrix
+ * 
+ */
+void test_out_of_core(int rank);
+
+/**
+ * @brief Benchmark the batched transposition of many small matrices against looping over matTransposeOMP
+ * 
+ */
+void test_batch(int rank, int size);
+
+/**
+ * @brief Benchmark the operations specialised on each element type
+ * 
+ */
+void test_types(int rank, int size);
+
+/**
+ * @brief Benchmark the packed storage of symmetric matrices against the dense transpositions
+ * 
+ */
+void test_packed(int rank, int size);
+
+/**
+ * @brief Benchmark the transposition of panels inside a larger matrix against dense transpositions of the same size
+ * 
+ */
+void test_strided(int rank);
+
+/**
+ * @brief Benchmark the sparse transpositions and symmetry check against the dense transposition, at several densities
+ * 
+ */
+void test_sparse(int rank, int size);
+
 #endif // TEST_H
\ No newline at end of file
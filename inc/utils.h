@@ -11,6 +11,8 @@
 
 #define MIN_MAT_SIZE 16
 #define MAX_MAT_SIZE 4096
+#define MAX_BATCH_MAT_SIZE 256
+#define BATCH_SIZE 1024
 // #define LOG_DEBUG 1
 
 /**
@@ -19,6 +21,14 @@
 typedef enum {
     TRANSPOSITION = 0,
     SYMMETRY = 1,
+    BATCH_TRANSPOSITION = 2,
+    BATCH_SYMMETRY = 3,
+    LOOP_TRANSPOSITION = 4, // batch transposed calling the single matrix function in a loop
+    PACK_SYMMETRIC = 5,
+    UNPACK_SYMMETRIC = 6,
+    STRIDED_TRANSPOSITION = 7, // sub-matrix of a larger one transposed into a sub-matrix of another
+    SPARSE_TRANSPOSITION = 8,
+    SPARSE_SYMMETRY = 9,
     N_FUNCTIONS
 } func_t;
 
@@ -39,6 +49,7 @@ typedef enum {
   SEQUENTIAL = 0,
   OMP = 1,
   MPI = 2,
+  OOC = 3,
   N_IMPLEMENTATIONS
 } impl_t;
 
@@ -49,6 +60,10 @@ typedef enum {
     SCATTER = 0,
     BROADCAST = 1,
     REDUCE = 2,
+    FILE_IO = 3,
+    DATATYPE = 4,
+    PACKED = 5,
+    BATCH = 6, // matrices of a batch scattered whole
     N_MPI_IMPLEMENTATIONS
 } mpi_t;
 
@@ -98,14 +113,33 @@ void init_mat(float* M, int n);
 void init_symmetric_mat(float* M, int n);
 
 
+/**
+ * @brief Band of rows or columns owned by a cpu, split as evenly as possible: the first n % n_cpus cpus get one more
+ * 
+ * @param[in] n number of rows or columns to split
+ * @param[in] rank cpu owning the band
+ * @param[in] n_cpus number of cpus
+ * @param[out] count rows or columns in the band
+ * @param[out] offset first row or column of the band
+ */
+void get_band(int n, int rank, int n_cpus, int* count, int* offset);
+
+
 // LOG
 
 extern FILE* seq_log;
 extern FILE* mpi_log;
 extern FILE* omp_log;
+extern FILE* typed_log;
+extern FILE* sparse_log;
+extern FILE* batch_log;
+extern FILE* packed_log;
+extern FILE* strided_log;
 
 /**
- * @brief Open and initialize log file
+ * @brief Open and initialize log file, collectively on all cpus
+ * 
+ * Only rank 0 opens the file, whose header starts with the affinity of each cpu and thread (see print_affinity).
  * 
  * @param impl implementation whose data are being logged
  * 
@@ -114,6 +148,48 @@ extern FILE* omp_log;
 FILE* init_log(impl_t impl);
 
 
+/**
+ * @brief Open and initialize the log file of the element-type specialised operations, collectively on all cpus
+ * 
+ * @return FILE*
+ */
+FILE* init_typed_log();
+
+
+/**
+ * @brief Open and initialize the log file of the sparse matrix operations, collectively on all cpus
+ * 
+ * @return FILE*
+ */
+FILE* init_sparse_log();
+
+
+/**
+ * @brief Open and initialize the log file of the batched operations, collectively on all cpus
+ * 
+ * @return FILE*
+ */
+FILE* init_batch_log();
+
+
+/**
+ * @brief Open and initialize the log file of the packed storage operations, collectively on all cpus
+ * 
+ * Same columns as the OMP log, use print_log_omp.
+ * 
+ * @return FILE*
+ */
+FILE* init_packed_log();
+
+
+/**
+ * @brief Open and initialize the log file of the operations on sub-matrices, collectively on all cpus
+ * 
+ * @return FILE*
+ */
+FILE* init_strided_log();
+
+
 /**
  * @brief Close previously opened log file
  * 
@@ -163,6 +239,64 @@ void print_log_omp(FILE *log, const char *msg, func_t func, impl_t imp, int size
  */
 void print_log_mpi(FILE* log, const char* msg, func_t func, impl_t imp, mpi_t mpi_type, int size, int n_cpus, double execution_time_tot, double execution_time_no_msg);
 
+/**
+ * @brief Print log string on file and, if in debugging mode, on screen
+ * 
+ * @param log log file
+ * @param msg debug message
+ * @param func executing function
+ * @param imp implementation type
+ * @param type name of the element type
+ * @param size matrix size
+ * @param n_procs number of cpus or threads used to run
+ * @param execution_time time elapsed between start and end of execution of the function
+ */
+void print_log_typed(FILE* log, const char* msg, func_t func, impl_t imp, const char* type, int size, int n_procs, double execution_time);
+
+/**
+ * @brief Print log string on file and, if in debugging mode, on screen
+ * 
+ * @param log log file
+ * @param msg debug message
+ * @param func executing function
+ * @param imp implementation type
+ * @param size matrix size
+ * @param n_procs number of cpus or threads used to run
+ * @param nnz number of nonzeros of the matrix, density is computed from it
+ * @param execution_time time elapsed between start and end of execution of the function
+ */
+void print_log_sparse(FILE* log, const char* msg, func_t func, impl_t imp, int size, int n_procs, int nnz, double execution_time);
+
+/**
+ * @brief Print log string on file and, if in debugging mode, on screen
+ * 
+ * @param log log file
+ * @param msg debug message
+ * @param func executing function
+ * @param imp implementation type
+ * @param mpi_type MPI implementation type, only logged if imp is MPI
+ * @param size size of each matrix
+ * @param batch number of matrices
+ * @param n_procs number of cpus or threads used to run
+ * @param execution_time_tot time elapsed between start and end of the function
+ * @param execution_time_no_msg time elapsed not counting the time needed to pass messages, same as execution_time_tot if imp is not MPI
+ */
+void print_log_batch(FILE* log, const char* msg, func_t func, impl_t imp, mpi_t mpi_type, int size, int batch, int n_procs, double execution_time_tot, double execution_time_no_msg);
+
+/**
+ * @brief Print log string on file and, if in debugging mode, on screen
+ * 
+ * @param log log file
+ * @param msg debug message
+ * @param func executing function
+ * @param imp implementation type
+ * @param size size of the sub-matrix
+ * @param ld leading dimension of the matrix holding it
+ * @param n_threads number of threads used to run
+ * @param execution_time time elapsed between start and end of execution of the function
+ */
+void print_log_strided(FILE* log, const char* msg, func_t func, impl_t imp, int size, int ld, int n_threads, double execution_time);
+
 int get_num_threads();
 
 int get_min_mat_size();
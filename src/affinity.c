@@ -0,0 +1,322 @@
+#define _GNU_SOURCE // sched_setaffinity, sched_getaffinity
+
+#include "affinity.h"
+
+#include <mpi.h>
+#include <omp.h>
+#include <sched.h>
+#include <stdio.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+
+#define AFFINITY_DESC_LEN 256 // characters describing the binding of one thread
+
+/**
+ * @brief Position of a core in the node topology
+ */
+typedef struct {
+    int cpu;
+    int socket;
+    int core;
+    int slot; // index of the core within its socket
+} core_info_t;
+
+static affinity_t current_affinity = AFFINITY_NONE;
+
+
+const char* affinity2str(affinity_t affinity) {
+    switch (affinity) {
+        case AFFINITY_NONE:
+            return "NONE";
+        case AFFINITY_COMPACT:
+            return "COMPACT";
+        case AFFINITY_SCATTER:
+            return "SCATTER";
+        case AFFINITY_SOCKET:
+            return "SOCKET";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+
+affinity_t get_affinity() {
+    const char* env_affinity = getenv("PARCO_AFFINITY");
+    if (env_affinity) {
+        for (int i = 0; i < N_AFFINITIES; i++) {
+            if (strcasecmp(env_affinity, affinity2str(i)) == 0) {
+                return i;
+            }
+        }
+    }
+    return AFFINITY_NONE;
+}
+
+
+// TOPOLOGY
+static int read_topology(int cpu, const char* field) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, field);
+
+    int value = 0;
+    FILE* file = fopen(path, "r");
+    if (file != NULL) {
+        if (fscanf(file, "%d", &value) != 1) {
+            value = 0;
+        }
+        fclose(file);
+    }
+    return value;
+}
+
+
+static int cpu_numa_node(int cpu) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+
+    int node = 0;
+    DIR* dir = opendir(path);
+    if (dir != NULL) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (sscanf(entry->d_name, "node%d", &node) == 1) {
+                break;
+            }
+        }
+        closedir(dir);
+    }
+    return node;
+}
+
+
+/**
+ * @brief Write the members of a set as a list of ranges, e.g. "0-3,8", truncated to len characters
+ */
+static void set2str(const cpu_set_t* set, char* str, size_t len) {
+    size_t pos = 0;
+    str[0] = '\0';
+
+    for (int i = 0; i < CPU_SETSIZE && pos < len; i++) {
+        if (CPU_ISSET(i, set) && (i == 0 || !CPU_ISSET(i - 1, set))) {
+            int last = i;
+            while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set)) {
+                last++;
+            }
+            if (last > i) {
+                pos += snprintf(str + pos, len - pos, pos > 0 ? ",%d-%d" : "%d-%d", i, last);
+            } else {
+                pos += snprintf(str + pos, len - pos, pos > 0 ? ",%d" : "%d", i);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Describe the cpus the calling thread is bound to, with their sockets and NUMA nodes
+ */
+static void describe_binding(char* desc, size_t len) {
+    cpu_set_t mask, sockets, nodes;
+    sched_getaffinity(0, sizeof(mask), &mask);
+
+    // sockets and NUMA nodes are collected as sets too, indexed by their id
+    CPU_ZERO(&sockets);
+    CPU_ZERO(&nodes);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &mask)) {
+            CPU_SET(read_topology(cpu, "physical_package_id"), &sockets);
+            CPU_SET(cpu_numa_node(cpu), &nodes);
+        }
+    }
+
+    char cpus_str[AFFINITY_DESC_LEN], sockets_str[AFFINITY_DESC_LEN], nodes_str[AFFINITY_DESC_LEN];
+    set2str(&mask, cpus_str, sizeof(cpus_str));
+    set2str(&sockets, sockets_str, sizeof(sockets_str));
+    set2str(&nodes, nodes_str, sizeof(nodes_str));
+    snprintf(desc, len, "cores %s, sockets %s, numa nodes %s", cpus_str, sockets_str, nodes_str);
+}
+
+
+static int compare_compact(const void* a, const void* b) {
+    const core_info_t* x = a;
+    const core_info_t* y = b;
+    if (x->socket != y->socket) {
+        return x->socket - y->socket;
+    }
+    if (x->core != y->core) {
+        return x->core - y->core;
+    }
+    return x->cpu - y->cpu;
+}
+
+
+static int compare_scatter(const void* a, const void* b) {
+    const core_info_t* x = a;
+    const core_info_t* y = b;
+    if (x->slot != y->slot) {
+        return x->slot - y->slot;
+    }
+    return x->socket - y->socket;
+}
+
+
+/**
+ * @brief Cores this process may run on, sorted socket by socket
+ *
+ * With physical set, only the first hardware thread of each physical core is kept, so that
+ * SMT siblings are not handed out as separate cores.
+ */
+static int get_cores(core_info_t* cores, bool physical) {
+    cpu_set_t mask;
+    sched_getaffinity(0, sizeof(mask), &mask);
+
+    int n_cores = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &mask)) {
+            cores[n_cores].cpu = cpu;
+            cores[n_cores].socket = read_topology(cpu, "physical_package_id");
+            cores[n_cores].core = read_topology(cpu, "core_id");
+            n_cores++;
+        }
+    }
+
+    // siblings share socket and core_id, so they end up next to each other
+    qsort(cores, n_cores, sizeof(core_info_t), compare_compact);
+    if (physical) {
+        int n_physical = 0;
+        for (int i = 0; i < n_cores; i++) {
+            if (n_physical == 0 || cores[i].socket != cores[n_physical - 1].socket || cores[i].core != cores[n_physical - 1].core) {
+                cores[n_physical++] = cores[i];
+            }
+        }
+        n_cores = n_physical;
+    }
+
+    for (int i = 0; i < n_cores; i++) {
+        cores[i].slot = (i > 0 && cores[i].socket == cores[i - 1].socket) ? cores[i - 1].slot + 1 : 0;
+    }
+
+    return n_cores;
+}
+
+
+// AFFINITY
+void set_affinity(affinity_t affinity) {
+    current_affinity = affinity;
+    if (affinity == AFFINITY_NONE) {
+        return;
+    }
+
+    // cores are shared among the cpus on the same node
+    MPI_Comm node_comm;
+    int local_rank, local_size;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_rank(node_comm, &local_rank);
+    MPI_Comm_size(node_comm, &local_size);
+    MPI_Comm_free(&node_comm);
+
+    core_info_t* cores = malloc(sizeof(core_info_t) * CPU_SETSIZE);
+    int n_cores = get_cores(cores, true);
+    int n_threads = omp_get_max_threads();
+
+    // one core per thread is not possible, whole sockets are still shared
+    if ((affinity == AFFINITY_COMPACT || affinity == AFFINITY_SCATTER) && local_size * n_threads > n_cores) {
+        if (local_rank == 0) {
+            fprintf(stderr, "%d cpus with %d threads each do not fit in %d physical cores, affinity %s falls back to %s\n",
+                    local_size, n_threads, n_cores, affinity2str(affinity), affinity2str(AFFINITY_SOCKET));
+        }
+        affinity = AFFINITY_SOCKET;
+        current_affinity = affinity;
+    }
+
+    if (affinity == AFFINITY_SCATTER) {
+        qsort(cores, n_cores, sizeof(core_info_t), compare_scatter);
+    }
+
+    // whole socket for this cpu, every hardware thread included, sockets assigned round robin
+    cpu_set_t socket_mask;
+    CPU_ZERO(&socket_mask);
+    if (affinity == AFFINITY_SOCKET) {
+        n_cores = get_cores(cores, false);
+        int n_sockets = 0;
+        for (int i = 0; i < n_cores; i++) {
+            n_sockets += cores[i].slot == 0;
+        }
+        int socket = -1;
+        for (int i = 0; i < n_cores; i++) {
+            socket += cores[i].slot == 0;
+            if (socket == local_rank % n_sockets) {
+                CPU_SET(cores[i].cpu, &socket_mask);
+            }
+        }
+    }
+
+    // block of consecutive cores for this cpu, its threads one core each inside it
+    int block = n_cores / local_size;
+    int block_start = local_rank * block;
+
+    // each thread pins itself
+    #pragma omp parallel
+    {
+        cpu_set_t mask;
+        if (affinity == AFFINITY_SOCKET) {
+            mask = socket_mask;
+        } else {
+            CPU_ZERO(&mask);
+            CPU_SET(cores[block_start + omp_get_thread_num() % block].cpu, &mask);
+        }
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+            perror("Error setting affinity");
+        }
+    }
+
+    free(cores);
+}
+
+
+void print_affinity(FILE* log) {
+    int rank, n_cpus;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_cpus);
+
+    int n_threads = omp_get_max_threads();
+    char* local_descs = malloc(AFFINITY_DESC_LEN * n_threads);
+
+    // described by each thread on its own host, since rank 0 may not see the topology of the others
+    #pragma omp parallel
+    {
+        describe_binding(local_descs + omp_get_thread_num() * AFFINITY_DESC_LEN, AFFINITY_DESC_LEN);
+    }
+
+    char host[MPI_MAX_PROCESSOR_NAME] = { 0 };
+    int host_len;
+    MPI_Get_processor_name(host, &host_len);
+
+    char* descs = NULL;
+    char* hosts = NULL;
+    if (rank == 0) {
+        descs = malloc((size_t)AFFINITY_DESC_LEN * n_threads * n_cpus);
+        hosts = malloc(MPI_MAX_PROCESSOR_NAME * n_cpus);
+    }
+    MPI_Gather(local_descs, AFFINITY_DESC_LEN * n_threads, MPI_CHAR, descs, AFFINITY_DESC_LEN * n_threads, MPI_CHAR, 0, MPI_COMM_WORLD);
+    MPI_Gather(host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hosts, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        if (log != NULL) {
+            fprintf(log, "# affinity: %s\n", affinity2str(current_affinity));
+            for (int r = 0; r < n_cpus; r++) {
+                for (int t = 0; t < n_threads; t++) {
+                    fprintf(log, "# rank %d thread %d: host %s, %s\n",
+                            r, t, hosts + r * MPI_MAX_PROCESSOR_NAME, descs + ((size_t)r * n_threads + t) * AFFINITY_DESC_LEN);
+                }
+            }
+        }
+        free(descs);
+        free(hosts);
+    }
+
+    free(local_descs);
+}
@@ -1,6 +1,7 @@
 #include "test.h"
 #include "utils.h"
 #include "matrix_operations.h"
+#include "affinity.h"
 #include <mpi.h>
 #include <time.h>
 #include <stdio.h>
@@ -14,13 +15,28 @@ int main(int argc, char* argv[]) {
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
 
+    set_affinity(get_affinity());
+
     seq_log = init_log(SEQUENTIAL);
     mpi_log = init_log(MPI);
     omp_log = init_log(OMP);
+    typed_log = init_typed_log();
+    sparse_log = init_sparse_log();
+    batch_log = init_batch_log();
+    packed_log = init_packed_log();
+    strided_log = init_strided_log();
     
     for(int i=0; i < 5; i++){
         test_performance(rank, size);
     }
+
+    test_file_io(rank, size);
+    test_out_of_core(rank);
+    test_batch(rank, size);
+    test_types(rank, size);
+    test_packed(rank, size);
+    test_strided(rank);
+    test_sparse(rank, size);
     
     MPI_Barrier(MPI_COMM_WORLD);
 
@@ -29,6 +45,11 @@ int main(int argc, char* argv[]) {
     close_log(seq_log);
     close_log(mpi_log);
     close_log(omp_log);
+    close_log(typed_log);
+    close_log(sparse_log);
+    close_log(batch_log);
+    close_log(packed_log);
+    close_log(strided_log);
 
     return 0;
 }
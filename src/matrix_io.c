@@ -0,0 +1,208 @@
+#include "utils.h"
+#include "matrix_io.h"
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+
+bool valid_mat_header(const mat_header_t* header) {
+    return header->magic == MAT_FILE_MAGIC && header->elem_size == sizeof(float) && header->rows > 0 && header->cols > 0;
+}
+
+
+// SEQUENTIAL
+bool write_mat_file(const char* path, float* M, int rows, int cols) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        perror("Error opening matrix file");
+        return false;
+    }
+
+    mat_header_t header = { MAT_FILE_MAGIC, rows, cols, sizeof(float) };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+              && fwrite(M, sizeof(float), (size_t)rows * cols, file) == (size_t)rows * cols;
+    if (!ok) {
+        perror("Error writing matrix file");
+    }
+
+    fclose(file);
+    return ok;
+}
+
+
+float* read_mat_file(const char* path, int* rows, int* cols) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        perror("Error opening matrix file");
+        return NULL;
+    }
+
+    mat_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || !valid_mat_header(&header)) {
+        fprintf(stderr, "Invalid matrix file: %s\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    float* M = new_mat(header.rows, header.cols);
+    if (fread(M, sizeof(float), (size_t)header.rows * header.cols, file) != (size_t)header.rows * header.cols) {
+        fprintf(stderr, "Truncated matrix file: %s\n", path);
+        free_mat(M, header.rows);
+        fclose(file);
+        return NULL;
+    }
+
+    *rows = header.rows;
+    *cols = header.cols;
+
+    fclose(file);
+    return M;
+}
+
+
+// MPI-IO
+bool read_mat_header_MPI(MPI_File fh, mat_header_t* header) {
+    MPI_Status status;
+    int count;
+    MPI_File_read_at_all(fh, 0, header, sizeof(mat_header_t), MPI_BYTE, &status);
+    MPI_Get_count(&status, MPI_BYTE, &count);
+
+    return count == sizeof(mat_header_t) && valid_mat_header(header);
+}
+
+
+bool matReadColsMPI(MPI_File fh, float* local_M, int mat_size, int rank, int n_cpus) {
+    int chunk_size, chunk_start; // columns of this cpu
+    get_band(mat_size, rank, n_cpus, &chunk_size, &chunk_start);
+
+    // file view selecting this cpu's columns
+    int sizes[2]    = { mat_size, mat_size };
+    int subsizes[2] = { mat_size, chunk_size };
+    int starts[2]   = { 0, chunk_start };
+
+    MPI_Datatype cols_type;
+    MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_FLOAT, &cols_type);
+    MPI_Type_commit(&cols_type);
+
+    MPI_Status status;
+    int count;
+    MPI_File_set_view(fh, sizeof(mat_header_t), MPI_FLOAT, cols_type, "native", MPI_INFO_NULL);
+    MPI_File_read_at_all(fh, 0, local_M, mat_size * chunk_size, MPI_FLOAT, &status);
+    MPI_Get_count(&status, MPI_FLOAT, &count);
+
+    MPI_Type_free(&cols_type);
+
+    // a truncated file is short for some cpus only
+    bool ok = count == mat_size * chunk_size;
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_C_BOOL, MPI_LAND, MPI_COMM_WORLD);
+
+    return ok;
+}
+
+
+void matWriteRowsMPI(MPI_File fh, float* local_T, int mat_size, int rank, int n_cpus) {
+    int chunk_size, chunk_start; // rows of this cpu
+    get_band(mat_size, rank, n_cpus, &chunk_size, &chunk_start);
+
+    if (rank == 0) {
+        mat_header_t header = { MAT_FILE_MAGIC, mat_size, mat_size, sizeof(float) };
+        MPI_Status status;
+        MPI_File_write_at(fh, 0, &header, sizeof(header), MPI_BYTE, &status);
+    }
+
+    // file view selecting this cpu's rows
+    int sizes[2]    = { mat_size, mat_size };
+    int subsizes[2] = { chunk_size, mat_size };
+    int starts[2]   = { chunk_start, 0 };
+
+    MPI_Datatype rows_type;
+    MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_FLOAT, &rows_type);
+    MPI_Type_commit(&rows_type);
+
+    MPI_Status status;
+    MPI_File_set_view(fh, sizeof(mat_header_t), MPI_FLOAT, rows_type, "native", MPI_INFO_NULL);
+    MPI_File_write_at_all(fh, 0, local_T, chunk_size * mat_size, MPI_FLOAT, &status);
+
+    MPI_Type_free(&rows_type);
+}
+
+
+bool matTransposeFileMPI(const char* in_path, const char* out_path, int rank, int n_cpus) {
+    double start_total, end_total, start_compute, end_compute;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+
+    MPI_File in_fh, out_fh;
+    if (MPI_File_open(MPI_COMM_WORLD, in_path, MPI_MODE_RDONLY, MPI_INFO_NULL, &in_fh) != MPI_SUCCESS) {
+        if (rank == 0) {
+            fprintf(stderr, "Error opening matrix file: %s\n", in_path);
+        }
+        return false;
+    }
+
+    mat_header_t header;
+    MPI_Offset file_size;
+    MPI_File_get_size(in_fh, &file_size);
+    if (!read_mat_header_MPI(in_fh, &header) || header.rows != header.cols || header.rows < n_cpus
+        || file_size < (MPI_Offset)sizeof(mat_header_t) + (MPI_Offset)header.rows * (MPI_Offset)header.cols * (MPI_Offset)sizeof(float)) {
+        if (rank == 0) {
+            fprintf(stderr, "Invalid matrix file for %d cpus: %s\n", n_cpus, in_path);
+        }
+        MPI_File_close(&in_fh);
+        return false;
+    }
+
+    int mat_size = header.rows;
+    int chunk_size, chunk_start;
+    get_band(mat_size, rank, n_cpus, &chunk_size, &chunk_start);
+
+    // read local band of columns straight from the file
+    float* local_M = new_mat(mat_size, chunk_size);
+    bool ok = matReadColsMPI(in_fh, local_M, mat_size, rank, n_cpus);
+    MPI_File_close(&in_fh);
+    if (!ok) {
+        if (rank == 0) {
+            fprintf(stderr, "Truncated matrix file: %s\n", in_path);
+        }
+        free_mat(local_M, mat_size);
+        return false;
+    }
+
+    // local chunk transpose
+    float* local_T = new_mat(chunk_size, mat_size);
+    if (rank == 0) {
+        start_compute = MPI_Wtime();
+    }
+    for (int i = 0; i < mat_size; i++) {
+        for (int j = 0; j < chunk_size; j++) {
+            local_T[j * mat_size + i] = local_M[i * chunk_size + j];
+        }
+    }
+    if (rank == 0) {
+        end_compute = MPI_Wtime();
+    }
+
+    // write local band of rows straight to the file
+    ok = MPI_File_open(MPI_COMM_WORLD, out_path, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &out_fh) == MPI_SUCCESS;
+    if (ok) {
+        MPI_File_set_size(out_fh, sizeof(mat_header_t) + (MPI_Offset)mat_size * mat_size * sizeof(float));
+        matWriteRowsMPI(out_fh, local_T, mat_size, rank, n_cpus);
+        MPI_File_close(&out_fh);
+    } else if (rank == 0) {
+        fprintf(stderr, "Error opening matrix file: %s\n", out_path);
+    }
+
+    free_mat(local_M, mat_size);
+    free_mat(local_T, chunk_size);
+
+    if (rank == 0 && ok) {
+        end_total = MPI_Wtime();
+        print_log_mpi(mpi_log, "MPI-IO Parallelized Transposition", TRANSPOSITION, MPI, FILE_IO, mat_size, n_cpus, end_total - start_total, end_compute - start_compute);
+    }
+
+    return ok;
+}
@@ -12,19 +12,7 @@
 // TASK 1
 bool checkSym(float* M, int n) {
     double start = omp_get_wtime();
-    bool isSym = true;
-
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = i + 1; j < n; j++) {
-            if (M[i * n + j] != M[j * n + i]) { // Correct indexing for contiguous array
-                isSym = false;
-                break;
-            }
-        }
-        if (!isSym) {
-            break;
-        }
-    }
+    bool isSym = checkSymLd(M, n, n);
 
     double end = omp_get_wtime();
 
@@ -39,11 +27,7 @@ bool checkSym(float* M, int n) {
 void matTranspose(float* M, float* T, int n) {
     double start = omp_get_wtime();
 
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            T[j * n + i] = M[i * n + j]; 
-        }
-    }
+    matTransposeLd(M, n, T, n, n, n);
 
     double end = omp_get_wtime();
 
@@ -215,10 +199,106 @@ void matTransposeMPI_Bcast(float* M, float* T, int mat_size, int rank, int n_cpu
 }
 
 
+// MPI Scatter - Gather with transposing Datatypes
+void matTransposeMPI_Datatype(float* M, float* T, int mat_size, int rank, int n_cpus) {
+    double start_total, end_total;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+    // uneven bands of rows of M, columns of T, counted in rows for the gather and in elements for the scatter
+    int counts[n_cpus], offset[n_cpus], elem_counts[n_cpus], elem_offset[n_cpus];
+    for (int i = 0; i < n_cpus; i++) {
+        get_band(mat_size, i, n_cpus, &counts[i], &offset[i]);
+        elem_counts[i] = counts[i] * mat_size;
+        elem_offset[i] = offset[i] * mat_size;
+    }
+    int chunk_size = counts[rank];
+
+    // create datatype to gather: one column of T, resized to step one element to the next column,
+    // so that row i of the band of M lands in column i of the band of T
+    MPI_Datatype col_type, resized_col_type;
+    MPI_Type_vector(mat_size, // n blocks (one for each row of T)
+                    1, // one element in each block
+                    mat_size, // offset between rows (matrix width)
+                    MPI_FLOAT, &col_type);
+    MPI_Type_create_resized(col_type, 0, sizeof(float), &resized_col_type);
+    MPI_Type_commit(&resized_col_type);
+
+    // scattering row bands, rank 0 sends its own band straight from M
+    float* local_M = M;
+    if (rank == 0) {
+        MPI_Scatterv(M, elem_counts, elem_offset, MPI_FLOAT, MPI_IN_PLACE, chunk_size * mat_size, MPI_FLOAT, 0, MPI_COMM_WORLD);
+    } else {
+        local_M = new_mat(chunk_size, mat_size);
+        MPI_Scatterv(NULL, elem_counts, elem_offset, MPI_FLOAT, local_M, chunk_size * mat_size, MPI_FLOAT, 0, MPI_COMM_WORLD);
+    }
+
+    // gather row bands as column bands of T, the packing engine transposes
+    MPI_Gatherv(local_M, chunk_size * mat_size, MPI_FLOAT, T, counts, offset, resized_col_type, 0, MPI_COMM_WORLD);
+
+    if (rank != 0) {
+        free_mat(local_M, chunk_size);
+    }
+    MPI_Type_free(&col_type);
+    MPI_Type_free(&resized_col_type);
+
+    if (rank == 0) {
+        end_total = MPI_Wtime();
+        print_log_mpi(mpi_log, "MPI Parallelized Transposition (Datatypes)", TRANSPOSITION, MPI, DATATYPE, mat_size, n_cpus, end_total - start_total, 0.0);
+    }
+}
+
+
 // TASK 4
 bool checkSymOMP(float* M, int n) {
     double start = omp_get_wtime();
 
+    bool isSym = checkSymOMPLd(M, n, n);
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+
+    print_log_omp(omp_log, "OMP Parallelized Symmetry Check", SYMMETRY, OMP, n, n_threads, end - start);
+
+    return isSym;
+}
+
+
+void matTransposeOMP(float* M, float* T, int n){
+    double start = omp_get_wtime();
+
+    matTransposeOMPLd(M, n, T, n, n, n);
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_omp(omp_log, "OMP Parallelized Transposition", TRANSPOSITION, OMP, n, n_threads, end - start);
+}
+
+
+// STRIDED
+bool checkSymLd(float* M, int lda, int n) {
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (M[(size_t)i * lda + j] != M[(size_t)j * lda + i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+void matTransposeLd(float* M, int lda, float* T, int ldt, int rows, int cols) {
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            T[(size_t)j * ldt + i] = M[(size_t)i * lda + j];
+        }
+    }
+}
+
+
+bool checkSymOMPLd(float* M, int lda, int n) {
     int i;
     bool isSym = true;
 
@@ -227,37 +307,186 @@ bool checkSymOMP(float* M, int n) {
 
         #pragma omp parallel for collapse(1) reduction(&:isSym)
         for (int j = i + 1; j < n; j++) {
-            if (M[i * n + j] != M[j * n + i]) {
+            if (M[(size_t)i * lda + j] != M[(size_t)j * lda + i]) {
                 isSym = false;
             }
         }
     }
 
+    return isSym;
+}
+
+
+void matTransposeOMPLd(float* M, int lda, float* T, int ldt, int rows, int cols) {
+    int i, j;
+
+    #pragma omp parallel for collapse(2)
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            T[(size_t)j * ldt + i] = M[(size_t)i * lda + j];
+        }
+    }
+}
+
+
+// BATCH
+void matTransposeBatchOMP(float* M, float* T, int n, int batch) {
+    double start = omp_get_wtime();
+
+    int b;
+    size_t mat_elems = (size_t)n * n;
+
+    // small matrices: one whole matrix per iteration, no team fork per matrix
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < batch; b++) {
+        matTransposeLd(M + b * mat_elems, n, T + b * mat_elems, n, n, n);
+    }
+
     double end = omp_get_wtime();
     int n_threads = get_num_threads();
+    print_log_batch(batch_log, "OMP Batched Transposition", BATCH_TRANSPOSITION, OMP, BATCH, n, batch, n_threads, end - start, end - start);
+}
 
-    print_log_omp(omp_log, "OMP Parallelized Symmetry Check", SYMMETRY, OMP, n, n_threads, end - start);
 
-    return isSym;
+void matTransposeBatchPtrOMP(float** M, float** T, int n, int batch) {
+    double start = omp_get_wtime();
+
+    int b;
+
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < batch; b++) {
+        matTransposeLd(M[b], n, T[b], n, n, n);
+    }
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_batch(batch_log, "OMP Batched Transposition (pointer array)", BATCH_TRANSPOSITION, OMP, BATCH, n, batch, n_threads, end - start, end - start);
 }
 
 
-void matTransposeOMP(float* M, float* T, int n){
+bool checkSymBatchOMP(float* M, bool* isSym, int n, int batch) {
     double start = omp_get_wtime();
 
-    int i, j;
-    
-    #pragma omp parallel for collapse(2)
-    for (i=0; i < n; i++) {
-        for (j=0; j < n; j++) {
-            T[j * n + i] = M[i * n + j];
-        }
-    }
+    int b;
+    bool allSym = true;
+    size_t mat_elems = (size_t)n * n;
 
+    #pragma omp parallel for schedule(static) reduction(&:allSym)
+    for (b = 0; b < batch; b++) {
+        isSym[b] = checkSymLd(M + b * mat_elems, n, n);
+        allSym &= isSym[b];
+    }
 
     double end = omp_get_wtime();
     int n_threads = get_num_threads();
-    print_log_omp(omp_log, "OMP Parallelized Transposition", TRANSPOSITION, OMP, n, n_threads, end - start);
+    print_log_batch(batch_log, "OMP Batched Symmetry Check", BATCH_SYMMETRY, OMP, BATCH, n, batch, n_threads, end - start, end - start);
+
+    return allSym;
+}
+
+
+void matTransposeBatchMPI(float* M, float* T, int n, int batch, int rank, int n_cpus) {
+    double start_total, end_total, start_compute, end_compute;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+
+    // one datatype per call covering a whole matrix
+    MPI_Datatype mat_type;
+    MPI_Type_contiguous(n * n, MPI_FLOAT, &mat_type);
+    MPI_Type_commit(&mat_type);
+
+    // batch entries split as evenly as possible, first cpus get one more
+    int counts[n_cpus], offset[n_cpus];
+    for (int i = 0; i < n_cpus; i++) {
+        counts[i] = batch / n_cpus + (i < batch % n_cpus ? 1 : 0);
+        offset[i] = i == 0 ? 0 : offset[i - 1] + counts[i - 1];
+    }
+    int local_batch = counts[rank];
+
+    float* local_M = new_mat(local_batch * n, n);
+    float* local_T = new_mat(local_batch * n, n);
+    MPI_Scatterv(M, counts, offset, mat_type, local_M, local_batch, mat_type, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        start_compute = MPI_Wtime();
+    }
+    int b;
+    size_t mat_elems = (size_t)n * n;
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < local_batch; b++) {
+        matTransposeLd(local_M + b * mat_elems, n, local_T + b * mat_elems, n, n, n);
+    }
+    if (rank == 0) {
+        end_compute = MPI_Wtime();
+    }
+
+    MPI_Gatherv(local_T, local_batch, mat_type, T, counts, offset, mat_type, 0, MPI_COMM_WORLD);
+
+    free_mat(local_M, local_batch * n);
+    free_mat(local_T, local_batch * n);
+    MPI_Type_free(&mat_type);
+
+    if (rank == 0) {
+        end_total = MPI_Wtime();
+        print_log_batch(batch_log, "MPI Batched Transposition", BATCH_TRANSPOSITION, MPI, BATCH, n, batch, n_cpus, end_total - start_total, end_compute - start_compute);
+    }
+}
+
+
+bool checkSymBatchMPI(float* M, bool* isSym, int n, int batch, int rank, int n_cpus) {
+    double start_total, end_total, start_compute, end_compute;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+
+    MPI_Datatype mat_type;
+    MPI_Type_contiguous(n * n, MPI_FLOAT, &mat_type);
+    MPI_Type_commit(&mat_type);
+
+    // same split of the batch as matTransposeBatchMPI
+    int counts[n_cpus], offset[n_cpus];
+    for (int i = 0; i < n_cpus; i++) {
+        counts[i] = batch / n_cpus + (i < batch % n_cpus ? 1 : 0);
+        offset[i] = i == 0 ? 0 : offset[i - 1] + counts[i - 1];
+    }
+    int local_batch = counts[rank];
+
+    float* local_M = new_mat(local_batch * n, n);
+    bool* local_isSym = malloc(sizeof(bool) * local_batch);
+    MPI_Scatterv(M, counts, offset, mat_type, local_M, local_batch, mat_type, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        start_compute = MPI_Wtime();
+    }
+    int b;
+    bool localSym = true;
+    size_t mat_elems = (size_t)n * n;
+    #pragma omp parallel for schedule(static) reduction(&:localSym)
+    for (b = 0; b < local_batch; b++) {
+        local_isSym[b] = checkSymLd(local_M + b * mat_elems, n, n);
+        localSym &= local_isSym[b];
+    }
+    if (rank == 0) {
+        end_compute = MPI_Wtime();
+    }
+
+    bool allSym;
+    MPI_Gatherv(local_isSym, local_batch, MPI_C_BOOL, isSym, counts, offset, MPI_C_BOOL, 0, MPI_COMM_WORLD);
+    MPI_Allreduce(&localSym, &allSym, 1, MPI_C_BOOL, MPI_LAND, MPI_COMM_WORLD);
+
+    free_mat(local_M, local_batch * n);
+    free(local_isSym);
+    MPI_Type_free(&mat_type);
+
+    if (rank == 0) {
+        end_total = MPI_Wtime();
+        print_log_batch(batch_log, "MPI Batched Symmetry Check", BATCH_SYMMETRY, MPI, BATCH, n, batch, n_cpus, end_total - start_total, end_compute - start_compute);
+    }
+
+    return allSym;
 }
 
 
@@ -273,3 +502,14 @@ bool check_transpose(float* M, float* T, int size){
     }
     return true;
 }
+
+
+bool check_transpose_batch(float* M, float* T, int size, int batch){
+    size_t mat_elems = (size_t)size * size;
+    for (int b = 0; b < batch; b++) {
+        if (!check_transpose(M + b * mat_elems, T + b * mat_elems, size)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,221 @@
+#include "utils.h"
+#include "matrix_typed.h"
+
+#include <mpi.h>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+const char* elem2str(elem_t elem) {
+    switch (elem) {
+#define X(type, sfx, mpi_type, name) case ELEM_##sfx: return name;
+        MAT_ELEM_TYPES(X)
+#undef X
+        default:
+            return "UNKNOWN";
+    }
+}
+
+
+// random values for each element type
+static float rand_f32() {
+    return ((float)rand()) / RAND_MAX;
+}
+
+static double rand_f64() {
+    return ((double)rand()) / RAND_MAX;
+}
+
+static int32_t rand_i32() {
+    return rand();
+}
+
+static int16_t rand_i16() {
+    return rand() & 0x7FFF;
+}
+
+static bf16_t rand_bf16() {
+    float f = rand_f32();
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits >> 16; // truncate to the upper half
+}
+
+
+/**
+ * @brief Define the operations declared by DECLARE_TYPED_OPERATIONS for one element type
+ */
+#define DEFINE_TYPED_OPERATIONS(type, sfx, mpi_type, name) \
+\
+type* new_mat_##sfx(int rows, int cols) { \
+    return malloc(sizeof(type) * rows * cols); \
+} \
+\
+void free_mat_##sfx(type* M) { \
+    free(M); \
+} \
+\
+void init_mat_##sfx(type* M, int n) { \
+    for (int i = 0; i < n; i++) { \
+        for (int j = 0; j < n; j++) { \
+            M[i * n + j] = rand_##sfx(); \
+        } \
+    } \
+} \
+\
+void init_symmetric_mat_##sfx(type* M, int n) { \
+    for (int i = 0; i < n; i++) { \
+        for (int j = i; j < n; j++) { \
+            M[i * n + j] = rand_##sfx(); \
+            M[j * n + i] = M[i * n + j]; \
+        } \
+    } \
+} \
+\
+/* transpose one tile, tile side chosen so that a tile row spans MAT_TILE_BYTES whatever the element width */ \
+/* a tile row is one vector of MAT_TILE_BYTES, read contiguously and stored with stride n */ \
+static void transpose_tile_##sfx(type* restrict M, type* restrict T, int n, int i0, int j0) { \
+    const int tile = MAT_TILE_BYTES / sizeof(type); \
+    int i_end = i0 + tile < n ? i0 + tile : n; \
+    int j_end = j0 + tile < n ? j0 + tile : n; \
+    for (int i = i0; i < i_end; i++) { \
+        _Pragma("omp simd") \
+        for (int j = j0; j < j_end; j++) { \
+            T[j * n + i] = M[i * n + j]; \
+        } \
+    } \
+} \
+\
+bool checkSym_##sfx(type* M, int n) { \
+    double start = omp_get_wtime(); \
+    bool isSym = true; \
+\
+    for (int i = 0; i < n - 1 && isSym; i++) { \
+        for (int j = i + 1; j < n; j++) { \
+            if (M[i * n + j] != M[j * n + i]) { \
+                isSym = false; \
+                break; \
+            } \
+        } \
+    } \
+\
+    double end = omp_get_wtime(); \
+    print_log_typed(typed_log, "Sequential Symmetry Check", SYMMETRY, SEQUENTIAL, name, n, 1, end - start); \
+\
+    return isSym; \
+} \
+\
+bool checkSymOMP_##sfx(type* M, int n) { \
+    double start = omp_get_wtime(); \
+    bool isSym = true; \
+    int i; \
+\
+    /* rows get shorter, dynamic schedule to balance the triangle */ \
+    _Pragma("omp parallel for schedule(dynamic, 16) reduction(&:isSym)") \
+    for (i = 0; i < n - 1; i++) { \
+        for (int j = i + 1; j < n; j++) { \
+            if (M[i * n + j] != M[j * n + i]) { \
+                isSym = false; \
+            } \
+        } \
+    } \
+\
+    double end = omp_get_wtime(); \
+    print_log_typed(typed_log, "OMP Parallelized Symmetry Check", SYMMETRY, OMP, name, n, get_num_threads(), end - start); \
+\
+    return isSym; \
+} \
+\
+void matTranspose_##sfx(type* M, type* T, int n) { \
+    double start = omp_get_wtime(); \
+    const int tile = MAT_TILE_BYTES / sizeof(type); \
+\
+    for (int i0 = 0; i0 < n; i0 += tile) { \
+        for (int j0 = 0; j0 < n; j0 += tile) { \
+            transpose_tile_##sfx(M, T, n, i0, j0); \
+        } \
+    } \
+\
+    double end = omp_get_wtime(); \
+    print_log_typed(typed_log, "Sequential Transposition", TRANSPOSITION, SEQUENTIAL, name, n, 1, end - start); \
+} \
+\
+void matTransposeOMP_##sfx(type* M, type* T, int n) { \
+    double start = omp_get_wtime(); \
+    const int tile = MAT_TILE_BYTES / sizeof(type); \
+    int i0, j0; \
+\
+    _Pragma("omp parallel for collapse(2)") \
+    for (i0 = 0; i0 < n; i0 += tile) { \
+        for (j0 = 0; j0 < n; j0 += tile) { \
+            transpose_tile_##sfx(M, T, n, i0, j0); \
+        } \
+    } \
+\
+    double end = omp_get_wtime(); \
+    print_log_typed(typed_log, "OMP Parallelized Transposition", TRANSPOSITION, OMP, name, n, get_num_threads(), end - start); \
+} \
+\
+void matTransposeMPI_##sfx(type* M, type* T, int n, int rank, int n_cpus) { \
+    double start = MPI_Wtime(); \
+\
+    /* uneven bands of columns, counted in columns for the scatter and in elements for the gather */ \
+    int counts[n_cpus], offset[n_cpus], elem_counts[n_cpus], elem_offset[n_cpus]; \
+    for (int i = 0; i < n_cpus; i++) { \
+        get_band(n, i, n_cpus, &counts[i], &offset[i]); \
+        elem_counts[i] = counts[i] * n; \
+        elem_offset[i] = offset[i] * n; \
+    } \
+    int chunk_size = counts[rank]; \
+\
+    /* one column of M, and of the local band, resized to step to the next column */ \
+    MPI_Datatype col_type, resized_col_type, local_col_type, resized_local_col_type; \
+    MPI_Type_vector(n, 1, n, mpi_type, &col_type); \
+    MPI_Type_create_resized(col_type, 0, sizeof(type), &resized_col_type); \
+    MPI_Type_commit(&resized_col_type); \
+    MPI_Type_vector(n, 1, chunk_size, mpi_type, &local_col_type); \
+    MPI_Type_create_resized(local_col_type, 0, sizeof(type), &resized_local_col_type); \
+    MPI_Type_commit(&resized_local_col_type); \
+\
+    type* local_M = new_mat_##sfx(n, chunk_size); \
+    MPI_Scatterv(M, counts, offset, resized_col_type, local_M, chunk_size, resized_local_col_type, 0, MPI_COMM_WORLD); \
+\
+    type* local_T = new_mat_##sfx(chunk_size, n); \
+    for (int i = 0; i < n; i++) { \
+        for (int j = 0; j < chunk_size; j++) { \
+            local_T[j * n + i] = local_M[i * chunk_size + j]; \
+        } \
+    } \
+\
+    MPI_Gatherv(local_T, n * chunk_size, mpi_type, T, elem_counts, elem_offset, mpi_type, 0, MPI_COMM_WORLD); \
+\
+    free_mat_##sfx(local_M); \
+    free_mat_##sfx(local_T); \
+    MPI_Type_free(&col_type); \
+    MPI_Type_free(&resized_col_type); \
+    MPI_Type_free(&local_col_type); \
+    MPI_Type_free(&resized_local_col_type); \
+\
+    if (rank == 0) { \
+        double end = MPI_Wtime(); \
+        print_log_typed(typed_log, "MPI Parallelized Transposition", TRANSPOSITION, MPI, name, n, n_cpus, end - start); \
+    } \
+} \
+\
+bool check_transpose_##sfx(type* M, type* T, int n) { \
+    for (int i = 0; i < n; i++) { \
+        for (int j = 0; j < n; j++) { \
+            if (M[i * n + j] != T[j * n + i]) { \
+                printf("TRANSPOSITION WENT WRONG! (%s)\n", name); \
+                return false; \
+            } \
+        } \
+    } \
+    return true; \
+}
+
+MAT_ELEM_TYPES(DEFINE_TYPED_OPERATIONS)
@@ -0,0 +1,174 @@
+#define _GNU_SOURCE // madvise, sync_file_range
+
+#include "utils.h"
+#include "matrix_io.h"
+#include "out_of_core.h"
+
+#include <omp.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/**
+ * @brief Number of rows of M in each panel, so that the panel and the strip of T it produces fit the budget
+ *
+ * Panels are kept a multiple of the tile side and never thinner than one tile, even if that exceeds the budget.
+ */
+static size_t panel_rows(size_t n, size_t mem_budget) {
+    if (n == 0) {
+        return OOC_TILE;
+    }
+
+    size_t rows = mem_budget / (2 * n * sizeof(float));
+
+    if (rows >= OOC_TILE) {
+        rows -= rows % OOC_TILE;
+    } else {
+        rows = OOC_TILE;
+    }
+    rows = rows < n ? rows : n;
+
+    if (2 * rows * n * sizeof(float) > mem_budget) {
+        fprintf(stderr, "Memory budget of %zu bytes too small, panels of %zu rows need %zu bytes\n", mem_budget, rows, 2 * rows * n * sizeof(float));
+    }
+
+    return rows;
+}
+
+
+/**
+ * @brief madvise a range of rows, widened to the enclosing pages
+ */
+static void advise_rows(float* rows, size_t bytes, int advice) {
+    size_t page_offset = (size_t)rows % sysconf(_SC_PAGESIZE);
+    madvise((char*)rows - page_offset, bytes + page_offset, advice);
+}
+
+
+/**
+ * @brief Start writeback of the pages of T completed by the panel of rows [r0, r1) of M, and release them
+ *
+ * The panel fills columns [r0, r1) of every row of T, so a page of a row is complete once it only holds
+ * columns below r1. Pages straddling two rows of T are left to the final msync.
+ */
+static void write_behind(int fd, char* map, size_t n, size_t r0, size_t r1) {
+    size_t page = sysconf(_SC_PAGESIZE);
+
+    for (size_t j = 0; j < n; j++) {
+        size_t row = sizeof(mat_header_t) + j * n * sizeof(float); // file offset of row j of T
+        size_t first = (row + page - 1) / page * page; // first page starting inside the row
+        size_t lo = (row + r0 * sizeof(float)) / page * page; // pages before lo were completed by previous panels
+        size_t hi = (row + r1 * sizeof(float)) / page * page;
+
+        lo = lo > first ? lo : first;
+        if (hi > lo) {
+            sync_file_range(fd, lo, hi - lo, SYNC_FILE_RANGE_WRITE);
+            madvise(map + lo, hi - lo, MADV_DONTNEED);
+        }
+    }
+}
+
+
+bool matTransposeOOC(const char* in_path, const char* out_path, size_t mem_budget) {
+    double start = omp_get_wtime();
+
+    int in_fd = open(in_path, O_RDONLY);
+    if (in_fd < 0) {
+        perror("Error opening matrix file");
+        return false;
+    }
+
+    mat_header_t header;
+    struct stat in_stat;
+    if (pread(in_fd, &header, sizeof(header), 0) != sizeof(header) || fstat(in_fd, &in_stat) != 0
+        || !valid_mat_header(&header) || header.rows != header.cols
+        || (size_t)in_stat.st_size < sizeof(header) + (size_t)header.rows * header.cols * sizeof(float)) {
+        fprintf(stderr, "Invalid matrix file: %s\n", in_path);
+        close(in_fd);
+        return false;
+    }
+
+    size_t n = header.rows;
+    size_t file_size = sizeof(header) + n * n * sizeof(float);
+
+    int out_fd = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0 || ftruncate(out_fd, file_size) != 0) {
+        perror("Error creating matrix file");
+        if (out_fd >= 0) {
+            close(out_fd);
+        }
+        close(in_fd);
+        return false;
+    }
+
+    char* in_map = mmap(NULL, file_size, PROT_READ, MAP_SHARED, in_fd, 0);
+    char* out_map = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, out_fd, 0);
+    if (in_map == MAP_FAILED || out_map == MAP_FAILED) {
+        perror("Error mapping matrix file");
+        if (in_map != MAP_FAILED) {
+            munmap(in_map, file_size);
+        }
+        if (out_map != MAP_FAILED) {
+            munmap(out_map, file_size);
+        }
+        close(in_fd);
+        close(out_fd);
+        return false;
+    }
+
+    *(mat_header_t*)out_map = header;
+    float* M = (float*)(in_map + sizeof(header));
+    float* T = (float*)(out_map + sizeof(header));
+
+    // panels of M are read front to back, strips of T are written once
+    madvise(in_map, file_size, MADV_SEQUENTIAL);
+
+    size_t panel = panel_rows(n, mem_budget);
+    for (size_t r0 = 0; r0 < n; r0 += panel) {
+        size_t r1 = r0 + panel < n ? r0 + panel : n;
+
+        // read-ahead of the next panel while this one is transposed
+        if (r1 < n) {
+            size_t next_rows = r1 + panel < n ? panel : n - r1;
+            advise_rows(M + r1 * n, next_rows * n * sizeof(float), MADV_WILLNEED);
+        }
+
+        long i0, j0;
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (j0 = 0; j0 < (long)n; j0 += OOC_TILE) {
+            for (i0 = r0; i0 < (long)r1; i0 += OOC_TILE) {
+                size_t i_end = (size_t)i0 + OOC_TILE < r1 ? (size_t)i0 + OOC_TILE : r1;
+                size_t j_end = (size_t)j0 + OOC_TILE < n ? (size_t)j0 + OOC_TILE : n;
+                for (size_t i = i0; i < i_end; i++) {
+                    for (size_t j = j0; j < j_end; j++) {
+                        T[j * n + i] = M[i * n + j];
+                    }
+                }
+            }
+        }
+
+        // write-behind of the strip just produced, and release the panel just consumed
+        write_behind(out_fd, out_map, n, r0, r1);
+        advise_rows(M + r0 * n, (r1 - r0) * n * sizeof(float), MADV_DONTNEED);
+    }
+
+    bool ok = msync(out_map, file_size, MS_SYNC) == 0;
+    if (!ok) {
+        perror("Error writing matrix file");
+    }
+
+    munmap(in_map, file_size);
+    munmap(out_map, file_size);
+    close(in_fd);
+    close(out_fd);
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_omp(omp_log, "Out-of-core Transposition", TRANSPOSITION, OOC, n, n_threads, end - start);
+
+    return ok;
+}
@@ -0,0 +1,109 @@
+#include "utils.h"
+#include "packed_matrix.h"
+
+#include <mpi.h>
+#include <omp.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+float* new_packed_mat(int n) {
+    float* P = malloc(sizeof(float) * packed_size(n));
+
+    return P;
+}
+
+
+void packSymOMP(float* M, float* P, int n) {
+    double start = omp_get_wtime();
+
+    int i;
+
+    // rows get shorter, dynamic schedule to balance the triangle
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (i = 0; i < n; i++) {
+        memcpy(P + packed_index(i, i, n), M + (size_t)i * n + i, sizeof(float) * (n - i));
+    }
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_omp(packed_log, "OMP Parallelized Symmetric Packing", PACK_SYMMETRIC, OMP, n, n_threads, end - start);
+}
+
+
+void unpackSymOMP(float* P, float* M, int n) {
+    double start = omp_get_wtime();
+
+    int i;
+
+    #pragma omp parallel for schedule(static)
+    for (i = 0; i < n; i++) {
+        for (int j = 0; j < i; j++) {
+            M[i * n + j] = P[packed_index(j, i, n)];
+        }
+        memcpy(M + (size_t)i * n + i, P + packed_index(i, i, n), sizeof(float) * (n - i));
+    }
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_omp(packed_log, "OMP Parallelized Symmetric Unpacking", UNPACK_SYMMETRIC, OMP, n, n_threads, end - start);
+}
+
+
+void matTransposePacked(float* P, float* PT, int n) {
+    if (P != PT) {
+        memcpy(PT, P, sizeof(float) * packed_size(n));
+    }
+}
+
+
+void matTransposePackedMPI_Bcast(float* P, float* T, int n, int rank, int n_cpus) {
+    double start_total, end_total, start_compute, end_compute;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+    // uneven bands of rows of T, counted in elements for the gather
+    int counts[n_cpus], offset[n_cpus];
+    for (int i = 0; i < n_cpus; i++) {
+        get_band(n, i, n_cpus, &counts[i], &offset[i]);
+        counts[i] *= n;
+        offset[i] *= n;
+    }
+    int chunk_size = counts[rank] / n;
+    int start = offset[rank] / n;
+    int end   = start + chunk_size;
+
+    // broadcast the packed matrix to all cpus
+    if (rank != 0) {
+        P = new_packed_mat(n);
+    }
+    MPI_Bcast(P, packed_size(n), MPI_FLOAT, 0, MPI_COMM_WORLD);
+
+    // local band unpack, T[i][j] = M[j][i] = M[i][j]
+    if (rank == 0) {
+        start_compute = MPI_Wtime();
+    }
+    float* local_T = new_mat(chunk_size, n);
+    for (int i = start; i < end; i++) {
+        for (int j = 0; j < i; j++) {
+            local_T[(i - start) * n + j] = P[packed_index(j, i, n)];
+        }
+        memcpy(local_T + (size_t)(i - start) * n + i, P + packed_index(i, i, n), sizeof(float) * (n - i));
+    }
+    if (rank == 0) {
+        end_compute = MPI_Wtime();
+    }
+
+    // gather transposed chunk
+    MPI_Gatherv(local_T, chunk_size * n, MPI_FLOAT, T, counts, offset, MPI_FLOAT, 0, MPI_COMM_WORLD);
+
+    free_mat(local_T, chunk_size);
+    if (rank != 0) {
+        free_mat(P, n);
+    }
+    if (rank == 0) {
+        end_total = MPI_Wtime();
+        print_log_mpi(mpi_log, "MPI Parallelized Packed Transposition", TRANSPOSITION, MPI, PACKED, n, n_cpus, end_total - start_total, end_compute - start_compute);
+    }
+}
@@ -0,0 +1,384 @@
+#include "utils.h"
+#include "sparse_operations.h"
+
+#include <mpi.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+// MATRIX
+csr_t* new_csr(int rows, int cols, int nnz) {
+    csr_t* A = malloc(sizeof(csr_t));
+    A->rows = rows;
+    A->cols = cols;
+    A->nnz = nnz;
+    A->row_ptr = malloc(sizeof(int) * (rows + 1));
+    A->col_idx = malloc(sizeof(int) * nnz);
+    A->val = malloc(sizeof(float) * nnz);
+
+    return A;
+}
+
+
+void free_csr(csr_t* A) {
+    if (A) {
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A->val);
+        free(A);
+    }
+}
+
+
+void init_sparse_mat(float* M, int n, float density) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            M[i * n + j] = ((float)rand()) / RAND_MAX < density ? ((float)rand()) / RAND_MAX : 0.0f;
+        }
+    }
+}
+
+
+void init_symmetric_sparse_mat(float* M, int n, float density) {
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) {
+            M[i * n + j] = ((float)rand()) / RAND_MAX < density ? ((float)rand()) / RAND_MAX : 0.0f;
+            M[j * n + i] = M[i * n + j];
+        }
+    }
+}
+
+
+csr_t* dense2csr(float* M, int n) {
+    int nnz = 0;
+    for (int k = 0; k < n * n; k++) {
+        nnz += M[k] != 0.0f;
+    }
+
+    csr_t* A = new_csr(n, n, nnz);
+    A->row_ptr[0] = 0;
+    for (int i = 0, pos = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (M[i * n + j] != 0.0f) {
+                A->col_idx[pos] = j;
+                A->val[pos] = M[i * n + j];
+                pos++;
+            }
+        }
+        A->row_ptr[i + 1] = pos;
+    }
+
+    return A;
+}
+
+
+void csr2dense(csr_t* A, float* M) {
+    memset(M, 0, sizeof(float) * A->rows * A->cols);
+    for (int i = 0; i < A->rows; i++) {
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            M[i * A->cols + A->col_idx[k]] = A->val[k];
+        }
+    }
+}
+
+
+/**
+ * @brief Transpose A into T, already allocated: histogram of the columns, prefix sum, placement
+ *
+ * Rows are visited in order, so column indices come out increasing within each row of T.
+ */
+static void transpose_csr(csr_t* A, csr_t* T) {
+    memset(T->row_ptr, 0, sizeof(int) * (A->cols + 1));
+    for (int k = 0; k < A->nnz; k++) {
+        T->row_ptr[A->col_idx[k] + 1]++;
+    }
+    for (int j = 0; j < A->cols; j++) {
+        T->row_ptr[j + 1] += T->row_ptr[j];
+    }
+
+    int* cursor = malloc(sizeof(int) * A->cols);
+    memcpy(cursor, T->row_ptr, sizeof(int) * A->cols);
+    for (int i = 0; i < A->rows; i++) {
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            int pos = cursor[A->col_idx[k]]++;
+            T->col_idx[pos] = i;
+            T->val[pos] = A->val[k];
+        }
+    }
+    free(cursor);
+}
+
+
+csr_t* coo2csr(int rows, int cols, int nnz, int* row_idx, int* col_idx, float* val) {
+    // bucket the entries by column, i.e. the transposition with unordered rows
+    csr_t* AT = new_csr(cols, rows, nnz);
+    memset(AT->row_ptr, 0, sizeof(int) * (cols + 1));
+    for (int k = 0; k < nnz; k++) {
+        AT->row_ptr[col_idx[k] + 1]++;
+    }
+    for (int j = 0; j < cols; j++) {
+        AT->row_ptr[j + 1] += AT->row_ptr[j];
+    }
+
+    int* cursor = malloc(sizeof(int) * cols);
+    memcpy(cursor, AT->row_ptr, sizeof(int) * cols);
+    for (int k = 0; k < nnz; k++) {
+        int pos = cursor[col_idx[k]]++;
+        AT->col_idx[pos] = row_idx[k];
+        AT->val[pos] = val[k];
+    }
+    free(cursor);
+
+    // transposing back orders the columns within each row
+    csr_t* A = new_csr(rows, cols, nnz);
+    transpose_csr(AT, A);
+    free_csr(AT);
+
+    return A;
+}
+
+
+// TRANSPOSITION
+csr_t* csrTranspose(csr_t* A) {
+    double start = omp_get_wtime();
+
+    csr_t* T = new_csr(A->cols, A->rows, A->nnz);
+    transpose_csr(A, T);
+
+    double end = omp_get_wtime();
+    print_log_sparse(sparse_log, "Sequential Sparse Transposition", SPARSE_TRANSPOSITION, SEQUENTIAL, A->rows, 1, A->nnz, end - start);
+
+    return T;
+}
+
+
+/**
+ * @brief Transpose A into T, already allocated, parallelized using OMP
+ */
+static void transpose_csr_omp(csr_t* A, csr_t* T) {
+    int cols = A->cols;
+
+    // offsets[t][j]: where thread t places its next nonzero of column j
+    int* offsets = malloc(sizeof(int) * omp_get_max_threads() * cols);
+
+    #pragma omp parallel
+    {
+        int t = omp_get_thread_num();
+        int n_threads = omp_get_num_threads();
+        int* my_offsets = offsets + t * cols;
+
+        // same bands of rows and columns in every phase
+        int r0 = (long)A->rows * t / n_threads;
+        int r1 = (long)A->rows * (t + 1) / n_threads;
+        int c0 = (long)cols * t / n_threads;
+        int c1 = (long)cols * (t + 1) / n_threads;
+
+        // histogram of the columns in this band of rows
+        memset(my_offsets, 0, sizeof(int) * cols);
+        for (int k = A->row_ptr[r0]; k < A->row_ptr[r1]; k++) {
+            my_offsets[A->col_idx[k]]++;
+        }
+        #pragma omp barrier
+
+        // exclusive prefix over the threads of each column, column totals in row_ptr
+        for (int j = c0; j < c1; j++) {
+            int sum = 0;
+            for (int s = 0; s < n_threads; s++) {
+                int count = offsets[s * cols + j];
+                offsets[s * cols + j] = sum;
+                sum += count;
+            }
+            T->row_ptr[j + 1] = sum;
+        }
+        #pragma omp barrier
+
+        // prefix sum over the columns, start of each row of T
+        #pragma omp single
+        {
+            T->row_ptr[0] = 0;
+            for (int j = 0; j < cols; j++) {
+                T->row_ptr[j + 1] += T->row_ptr[j];
+            }
+        }
+
+        for (int j = c0; j < c1; j++) {
+            for (int s = 0; s < n_threads; s++) {
+                offsets[s * cols + j] += T->row_ptr[j];
+            }
+        }
+        #pragma omp barrier
+
+        // placement, each thread in its own slots
+        for (int i = r0; i < r1; i++) {
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                int pos = my_offsets[A->col_idx[k]]++;
+                T->col_idx[pos] = i;
+                T->val[pos] = A->val[k];
+            }
+        }
+    }
+
+    free(offsets);
+}
+
+
+csr_t* csrTransposeOMP(csr_t* A) {
+    double start = omp_get_wtime();
+
+    csr_t* T = new_csr(A->cols, A->rows, A->nnz);
+    transpose_csr_omp(A, T);
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_sparse(sparse_log, "OMP Parallelized Sparse Transposition", SPARSE_TRANSPOSITION, OMP, A->rows, n_threads, A->nnz, end - start);
+
+    return T;
+}
+
+
+csr_t* csrTransposeMPI(csr_t* A, int rank, int n_cpus) {
+    double start_total, end_total;
+
+    if (rank == 0) {
+        start_total = MPI_Wtime();
+    }
+
+    int dims[2];
+    if (rank == 0) {
+        dims[0] = A->rows;
+        dims[1] = A->cols;
+    }
+    MPI_Bcast(dims, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    int rows = dims[0];
+    int cols = dims[1];
+
+    // bands of rows split as evenly as possible, first cpus get one more
+    int row_counts[n_cpus], row_offset[n_cpus], nnz_counts[n_cpus], nnz_offset[n_cpus];
+    for (int r = 0; r < n_cpus; r++) {
+        row_counts[r] = rows / n_cpus + (r < rows % n_cpus ? 1 : 0);
+        row_offset[r] = r == 0 ? 0 : row_offset[r - 1] + row_counts[r - 1];
+    }
+
+    int* row_len = NULL;
+    if (rank == 0) {
+        row_len = malloc(sizeof(int) * rows);
+        for (int i = 0; i < rows; i++) {
+            row_len[i] = A->row_ptr[i + 1] - A->row_ptr[i];
+        }
+        for (int r = 0; r < n_cpus; r++) {
+            nnz_offset[r] = A->row_ptr[row_offset[r]];
+            nnz_counts[r] = A->row_ptr[row_offset[r] + row_counts[r]] - nnz_offset[r];
+        }
+    }
+
+    int local_rows = row_counts[rank];
+    int local_nnz;
+    MPI_Scatter(nnz_counts, 1, MPI_INT, &local_nnz, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    // scattering bands of rows, row lengths rebuilt into local row pointers
+    csr_t* local_A = new_csr(local_rows, cols, local_nnz);
+    local_A->row_ptr[0] = 0;
+    MPI_Scatterv(row_len, row_counts, row_offset, MPI_INT, local_A->row_ptr + 1, local_rows, MPI_INT, 0, MPI_COMM_WORLD);
+    for (int i = 0; i < local_rows; i++) {
+        local_A->row_ptr[i + 1] += local_A->row_ptr[i];
+    }
+    MPI_Scatterv(rank == 0 ? A->col_idx : NULL, nnz_counts, nnz_offset, MPI_INT, local_A->col_idx, local_nnz, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Scatterv(rank == 0 ? A->val : NULL, nnz_counts, nnz_offset, MPI_FLOAT, local_A->val, local_nnz, MPI_FLOAT, 0, MPI_COMM_WORLD);
+
+    // local band transpose, back to global row indices
+    csr_t* local_T = new_csr(cols, local_rows, local_nnz);
+    transpose_csr(local_A, local_T);
+    for (int k = 0; k < local_nnz; k++) {
+        local_T->col_idx[k] += row_offset[rank];
+    }
+
+    // gather transposed bands
+    int* all_row_ptr = NULL;
+    csr_t* bands = NULL;
+    if (rank == 0) {
+        all_row_ptr = malloc(sizeof(int) * n_cpus * (cols + 1));
+        bands = new_csr(cols, rows, A->nnz);
+    }
+    MPI_Gather(local_T->row_ptr, cols + 1, MPI_INT, all_row_ptr, cols + 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(local_T->col_idx, local_nnz, MPI_INT, rank == 0 ? bands->col_idx : NULL, nnz_counts, nnz_offset, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(local_T->val, local_nnz, MPI_FLOAT, rank == 0 ? bands->val : NULL, nnz_counts, nnz_offset, MPI_FLOAT, 0, MPI_COMM_WORLD);
+
+    // row j of T is row j of each band, one after the other
+    csr_t* T = NULL;
+    if (rank == 0) {
+        T = new_csr(cols, rows, A->nnz);
+        T->row_ptr[0] = 0;
+        for (int j = 0; j < cols; j++) {
+            int pos = T->row_ptr[j];
+            for (int r = 0; r < n_cpus; r++) {
+                int* band_ptr = all_row_ptr + r * (cols + 1);
+                int len = band_ptr[j + 1] - band_ptr[j];
+                memcpy(T->col_idx + pos, bands->col_idx + nnz_offset[r] + band_ptr[j], sizeof(int) * len);
+                memcpy(T->val + pos, bands->val + nnz_offset[r] + band_ptr[j], sizeof(float) * len);
+                pos += len;
+            }
+            T->row_ptr[j + 1] = pos;
+        }
+
+        free(row_len);
+        free(all_row_ptr);
+        free_csr(bands);
+    }
+
+    free_csr(local_A);
+    free_csr(local_T);
+
+    if (rank == 0) {
+        end_total = MPI_Wtime();
+        print_log_sparse(sparse_log, "MPI Parallelized Sparse Transposition", SPARSE_TRANSPOSITION, MPI, rows, n_cpus, A->nnz, end_total - start_total);
+    }
+
+    return T;
+}
+
+
+// SYMMETRY
+bool csrCheckSymOMP(csr_t* A, bool* structural) {
+    double start = omp_get_wtime();
+
+    // a row of the transposition is sorted like a row of A, so they can be compared element by element
+    csr_t* T = new_csr(A->cols, A->rows, A->nnz);
+    transpose_csr_omp(A, T);
+
+    int i;
+    bool sameStructure = A->rows == A->cols;
+    bool isSym = sameStructure;
+
+    if (sameStructure) {
+        #pragma omp parallel for reduction(&:sameStructure, isSym)
+        for (i = 0; i < A->rows; i++) {
+            if (A->row_ptr[i + 1] != T->row_ptr[i + 1]) {
+                sameStructure = false;
+                isSym = false;
+                continue;
+            }
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                if (A->col_idx[k] != T->col_idx[k]) {
+                    sameStructure = false;
+                    isSym = false;
+                    break;
+                }
+                if (A->val[k] != T->val[k]) {
+                    isSym = false;
+                }
+            }
+        }
+    }
+
+    free_csr(T);
+    *structural = sameStructure;
+
+    double end = omp_get_wtime();
+    int n_threads = get_num_threads();
+    print_log_sparse(sparse_log, "OMP Parallelized Sparse Symmetry Check", SPARSE_SYMMETRY, OMP, A->rows, n_threads, A->nnz, end - start);
+
+    return isSym;
+}
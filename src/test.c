@@ -1,6 +1,33 @@
 #include "test.h"
 #include "utils.h"
 #include "matrix_operations.h"
+#include "matrix_io.h"
+#include "out_of_core.h"
+#include "matrix_typed.h"
+#include "packed_matrix.h"
+#include "sparse_operations.h"
+
+#include <omp.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAT_IN_PATH "../out/mat_in.bin"
+#define MAT_OUT_PATH "../out/mat_out.bin"
+
+#define N_DENSITIES 4
+static const float densities[N_DENSITIES] = { 0.001f, 0.01f, 0.05f, 0.2f };
+
+/**
+ * @brief Check that a batch symmetry check found every matrix symmetric
+ */
+static void check_sym_batch(bool allSym, bool* isSym, int batch) {
+    for (int b = 0; b < batch && allSym; b++) {
+        allSym = isSym[b];
+    }
+    if (!allSym) {
+        printf("BATCH SYMMETRY CHECK WENT WRONG!\n");
+    }
+}
 
 /**
  * @brief
@@ -79,6 +106,11 @@ void test_performance(int rank, int size){
             if(rank == 0) {
                 check_transpose(M, T, mat_size);
             }
+
+            matTransposeMPI_Datatype(M, T, mat_size, rank, size);
+            if(rank == 0) {
+                check_transpose(M, T, mat_size);
+            }
             // print_matrix(T, size);
 
             // TASK 4: parallelization using OMP
@@ -101,3 +133,346 @@ void test_performance(int rank, int size){
 
 
 }
+
+void test_file_io(int rank, int size){
+    int min_mat_size = get_min_mat_size();
+
+    for(int mat_size = min_mat_size; mat_size <= MAX_MAT_SIZE; mat_size *= 2){
+        if (rank == 0){
+            float* M = new_mat(mat_size, mat_size);
+            init_mat(M, mat_size);
+            write_mat_file(MAT_IN_PATH, M, mat_size, mat_size);
+            free_mat(M, mat_size);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        bool ok = true;
+        for (int i = 0; i < 5 && ok; i++) {
+            ok = matTransposeFileMPI(MAT_IN_PATH, MAT_OUT_PATH, rank, size);
+        }
+
+        // check result of the last transposition
+        if (rank == 0 && ok){
+            int rows, cols;
+            float* M = read_mat_file(MAT_IN_PATH, &rows, &cols);
+            float* T = read_mat_file(MAT_OUT_PATH, &rows, &cols);
+            if (M != NULL && T != NULL) {
+                check_transpose(M, T, mat_size);
+            }
+            free_mat(M, mat_size);
+            free_mat(T, mat_size);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (rank == 0){
+        remove(MAT_IN_PATH);
+        remove(MAT_OUT_PATH);
+    }
+}
+
+void test_out_of_core(int rank){
+    if (rank != 0){
+        return;
+    }
+
+    // from the smallest size where a quarter of the matrix still holds panels of OOC_TILE rows
+    for(int mat_size = 8 * OOC_TILE; mat_size <= MAX_MAT_SIZE; mat_size *= 2){
+        float* M = new_mat(mat_size, mat_size);
+        init_mat(M, mat_size);
+        write_mat_file(MAT_IN_PATH, M, mat_size, mat_size);
+
+        // a quarter of the matrix, forcing 8 panels
+        size_t mem_budget = (size_t)mat_size * mat_size * sizeof(float) / 4;
+        for (int i = 0; i < 5; i++) {
+            matTransposeOOC(MAT_IN_PATH, MAT_OUT_PATH, mem_budget);
+        }
+
+        int rows, cols;
+        float* T = read_mat_file(MAT_OUT_PATH, &rows, &cols);
+        if (T != NULL) {
+            check_transpose(M, T, mat_size);
+        }
+        free_mat(M, mat_size);
+        free_mat(T, mat_size);
+    }
+
+    remove(MAT_IN_PATH);
+    remove(MAT_OUT_PATH);
+}
+
+void test_batch(int rank, int size){
+    for(int mat_size = MIN_MAT_SIZE; mat_size <= MAX_BATCH_MAT_SIZE; mat_size *= 2){
+        size_t mat_elems = (size_t)mat_size * mat_size;
+        float* M = NULL;
+        float* T = NULL;
+        if (rank == 0){
+            M = new_mat(BATCH_SIZE * mat_size, mat_size);
+            T = new_mat(BATCH_SIZE * mat_size, mat_size);
+        }
+
+        for (int i = 0; i < 5; i++) {
+            if (rank == 0){
+                for (int b = 0; b < BATCH_SIZE; b++) {
+                    init_symmetric_mat(M + b * mat_elems, mat_size);
+                }
+
+                // baseline: one parallel region, and its overhead, per matrix
+                double start = omp_get_wtime();
+                for (int b = 0; b < BATCH_SIZE; b++) {
+                    matTransposeOMPLd(M + b * mat_elems, mat_size, T + b * mat_elems, mat_size, mat_size, mat_size);
+                }
+                double end = omp_get_wtime();
+                print_log_batch(batch_log, "OMP Looped Transposition", LOOP_TRANSPOSITION, OMP, BATCH, mat_size, BATCH_SIZE, get_num_threads(), end - start, end - start);
+                check_transpose_batch(M, T, mat_size, BATCH_SIZE);
+
+                bool isSym[BATCH_SIZE];
+                bool allSym = checkSymBatchOMP(M, isSym, mat_size, BATCH_SIZE);
+                check_sym_batch(allSym, isSym, BATCH_SIZE);
+
+                matTransposeBatchOMP(M, T, mat_size, BATCH_SIZE);
+                check_transpose_batch(M, T, mat_size, BATCH_SIZE);
+
+                float* M_ptr[BATCH_SIZE];
+                float* T_ptr[BATCH_SIZE];
+                for (int b = 0; b < BATCH_SIZE; b++) {
+                    M_ptr[b] = M + b * mat_elems;
+                    T_ptr[b] = T + b * mat_elems;
+                }
+                matTransposeBatchPtrOMP(M_ptr, T_ptr, mat_size, BATCH_SIZE);
+                check_transpose_batch(M, T, mat_size, BATCH_SIZE);
+            }
+
+            matTransposeBatchMPI(M, T, mat_size, BATCH_SIZE, rank, size);
+            if (rank == 0){
+                check_transpose_batch(M, T, mat_size, BATCH_SIZE);
+            }
+
+            bool isSym[BATCH_SIZE];
+            bool allSym = checkSymBatchMPI(M, isSym, mat_size, BATCH_SIZE, rank, size);
+            if (rank == 0){
+                check_sym_batch(allSym, isSym, BATCH_SIZE);
+            }
+        }
+
+        if (rank == 0){
+            free_mat(M, BATCH_SIZE * mat_size);
+            free_mat(T, BATCH_SIZE * mat_size);
+        }
+    }
+}
+
+void test_types(int rank, int size){
+    int min_mat_size = get_min_mat_size();
+
+    for(int mat_size = min_mat_size; mat_size <= MAX_MAT_SIZE; mat_size *= 2){
+        // same sequence of tests for each element type
+        #define X(type, sfx, mpi_type, name) \
+        { \
+            type* M = NULL; \
+            type* T = NULL; \
+            if (rank == 0){ \
+                M = new_mat_##sfx(mat_size, mat_size); \
+                T = new_mat_##sfx(mat_size, mat_size); \
+            } \
+            for (int i = 0; i < 5; i++) { \
+                if (rank == 0) { \
+                    init_symmetric_mat_##sfx(M, mat_size); \
+                    checkSym_##sfx(M, mat_size); \
+                    checkSymOMP_##sfx(M, mat_size); \
+                    init_mat_##sfx(M, mat_size); \
+                    matTranspose_##sfx(M, T, mat_size); \
+                    check_transpose_##sfx(M, T, mat_size); \
+                    matTransposeOMP_##sfx(M, T, mat_size); \
+                    check_transpose_##sfx(M, T, mat_size); \
+                } \
+                matTransposeMPI_##sfx(M, T, mat_size, rank, size); \
+                if (rank == 0) { \
+                    check_transpose_##sfx(M, T, mat_size); \
+                } \
+            } \
+            if (rank == 0){ \
+                free_mat_##sfx(M); \
+                free_mat_##sfx(T); \
+            } \
+        }
+        MAT_ELEM_TYPES(X)
+        #undef X
+    }
+}
+
+void test_packed(int rank, int size){
+    int min_mat_size = get_min_mat_size();
+
+    for(int mat_size = min_mat_size; mat_size <= MAX_MAT_SIZE; mat_size *= 2){
+        float* M = NULL;
+        float* T = NULL;
+        float* P = NULL;
+        if (rank == 0){
+            M = new_mat(mat_size, mat_size);
+            T = new_mat(mat_size, mat_size);
+            P = new_packed_mat(mat_size);
+        }
+
+        for (int i = 0; i < 5; i++) {
+            if (rank == 0){
+                init_symmetric_mat(M, mat_size);
+                packSymOMP(M, P, mat_size);
+
+                // transposing in packed form, then back to dense
+                matTransposePacked(P, P, mat_size);
+                unpackSymOMP(P, T, mat_size);
+                check_transpose(M, T, mat_size);
+            }
+
+            matTransposePackedMPI_Bcast(P, T, mat_size, rank, size);
+            if (rank == 0){
+                check_transpose(M, T, mat_size);
+            }
+
+            // dense baseline, broadcasting the whole matrix
+            matTransposeMPI_Bcast(M, T, mat_size, rank, size);
+            if (rank == 0){
+                check_transpose(M, T, mat_size);
+            }
+        }
+
+        if (rank == 0){
+            free_mat(M, mat_size);
+            free_mat(T, mat_size);
+            free_mat(P, mat_size);
+        }
+    }
+}
+
+void test_strided(int rank){
+    if (rank != 0){
+        return;
+    }
+
+    for(int mat_size = MIN_MAT_SIZE; mat_size <= MAX_MAT_SIZE / 2; mat_size *= 2){
+        // panel in the middle of a matrix twice as wide
+        int ld = 2 * mat_size;
+        float* big_M = new_mat(ld, ld);
+        float* big_T = new_mat(ld, ld);
+        float* panel = MAT_VIEW(big_M, ld, mat_size / 2, mat_size / 2);
+        float* panel_T = MAT_VIEW(big_T, ld, mat_size / 2, mat_size / 2);
+
+        float* M = new_mat(mat_size, mat_size);
+        float* T = new_mat(mat_size, mat_size);
+
+        for (int i = 0; i < 5; i++) {
+            init_mat(big_M, ld);
+
+            double start = omp_get_wtime();
+            matTransposeOMPLd(panel, ld, panel_T, ld, mat_size, mat_size);
+            double end = omp_get_wtime();
+            print_log_strided(strided_log, "OMP Parallelized Strided Transposition", STRIDED_TRANSPOSITION, OMP, mat_size, ld, get_num_threads(), end - start);
+
+            // copy the panels out to check them
+            for (int r = 0; r < mat_size; r++) {
+                memcpy(M + r * mat_size, MAT_VIEW(panel, ld, r, 0), sizeof(float) * mat_size);
+                memcpy(T + r * mat_size, MAT_VIEW(panel_T, ld, r, 0), sizeof(float) * mat_size);
+            }
+            check_transpose(M, T, mat_size);
+
+            // same panel, sequential
+            start = omp_get_wtime();
+            matTransposeLd(panel, ld, panel_T, ld, mat_size, mat_size);
+            end = omp_get_wtime();
+            print_log_strided(strided_log, "Sequential Strided Transposition", STRIDED_TRANSPOSITION, SEQUENTIAL, mat_size, ld, 1, end - start);
+            for (int r = 0; r < mat_size; r++) {
+                memcpy(T + r * mat_size, MAT_VIEW(panel_T, ld, r, 0), sizeof(float) * mat_size);
+            }
+            check_transpose(M, T, mat_size);
+
+            // dense baseline of the same size
+            start = omp_get_wtime();
+            matTransposeOMPLd(M, mat_size, T, mat_size, mat_size, mat_size);
+            end = omp_get_wtime();
+            print_log_strided(strided_log, "OMP Parallelized Transposition", TRANSPOSITION, OMP, mat_size, mat_size, get_num_threads(), end - start);
+            check_transpose(M, T, mat_size);
+
+            // symmetric panel, then the same panel with one element off
+            init_symmetric_mat(M, mat_size);
+            for (int r = 0; r < mat_size; r++) {
+                memcpy(MAT_VIEW(panel, ld, r, 0), M + r * mat_size, sizeof(float) * mat_size);
+            }
+            bool isSym = checkSymLd(panel, ld, mat_size) && checkSymOMPLd(panel, ld, mat_size);
+            *MAT_VIEW(panel, ld, 0, 1) += 1.0f;
+            bool isNonSym = !checkSymLd(panel, ld, mat_size) && !checkSymOMPLd(panel, ld, mat_size);
+            if (!isSym || !isNonSym) {
+                printf("STRIDED SYMMETRY CHECK WENT WRONG!\n");
+            }
+        }
+
+        free_mat(big_M, ld);
+        free_mat(big_T, ld);
+        free_mat(M, mat_size);
+        free_mat(T, mat_size);
+    }
+}
+
+void test_sparse(int rank, int size){
+    int min_mat_size = get_min_mat_size();
+
+    for(int mat_size = min_mat_size; mat_size <= MAX_MAT_SIZE; mat_size *= 2){
+        float* M = NULL;
+        float* T = NULL;
+        if (rank == 0){
+            M = new_mat(mat_size, mat_size);
+            T = new_mat(mat_size, mat_size);
+        }
+
+        for (int d = 0; d < N_DENSITIES; d++) {
+            for (int i = 0; i < 5; i++) {
+                csr_t* A = NULL;
+                csr_t* AT = NULL;
+                if (rank == 0){
+                    init_sparse_mat(M, mat_size, densities[d]);
+                    A = dense2csr(M, mat_size);
+
+                    AT = csrTranspose(A);
+                    csr2dense(AT, T);
+                    check_transpose(M, T, mat_size);
+                    free_csr(AT);
+
+                    AT = csrTransposeOMP(A);
+                    csr2dense(AT, T);
+                    check_transpose(M, T, mat_size);
+                    free_csr(AT);
+
+                    // dense baseline at the same density
+                    double start = omp_get_wtime();
+                    matTransposeOMPLd(M, mat_size, T, mat_size, mat_size, mat_size);
+                    double end = omp_get_wtime();
+                    print_log_sparse(sparse_log, "OMP Parallelized Dense Transposition", TRANSPOSITION, OMP, mat_size, get_num_threads(), A->nnz, end - start);
+                }
+
+                AT = csrTransposeMPI(A, rank, size);
+                if (rank == 0){
+                    csr2dense(AT, T);
+                    check_transpose(M, T, mat_size);
+                    free_csr(AT);
+
+                    // random matrices can still be symmetric when almost empty, only the symmetric one is checked
+                    bool structural;
+                    csrCheckSymOMP(A, &structural);
+                    free_csr(A);
+
+                    init_symmetric_sparse_mat(M, mat_size, densities[d]);
+                    A = dense2csr(M, mat_size);
+                    if (!csrCheckSymOMP(A, &structural) || !structural) {
+                        printf("SPARSE SYMMETRY CHECK WENT WRONG!\n");
+                    }
+                    free_csr(A);
+                }
+            }
+        }
+
+        if (rank == 0){
+            free_mat(M, mat_size);
+            free_mat(T, mat_size);
+        }
+    }
+}
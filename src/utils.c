@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "affinity.h"
 
 #include <mpi.h>
 #include <math.h>
@@ -14,6 +15,22 @@ const char* func2str(func_t function) {
             return "TRANSPOSITION";
         case SYMMETRY:
             return "SYMMETRY";
+        case BATCH_TRANSPOSITION:
+            return "BATCH_TRANSPOSITION";
+        case BATCH_SYMMETRY:
+            return "BATCH_SYMMETRY";
+        case LOOP_TRANSPOSITION:
+            return "LOOP_TRANSPOSITION";
+        case PACK_SYMMETRIC:
+            return "PACK_SYMMETRIC";
+        case UNPACK_SYMMETRIC:
+            return "UNPACK_SYMMETRIC";
+        case STRIDED_TRANSPOSITION:
+            return "STRIDED_TRANSPOSITION";
+        case SPARSE_TRANSPOSITION:
+            return "SPARSE_TRANSPOSITION";
+        case SPARSE_SYMMETRY:
+            return "SPARSE_SYMMETRY";
         default:
             return "UNKNOWN";
     }
@@ -27,6 +44,8 @@ const char* imp2str(impl_t implementation) {
             return "OMP";
         case MPI:
             return "MPI";
+        case OOC:
+            return "OUT_OF_CORE";
         default:
             return "UNKNOWN";
     }
@@ -40,6 +59,14 @@ const char* mpi2str(mpi_t mpi_type) {
             return "BROADCAST";
         case REDUCE:
             return "REDUCE";
+        case FILE_IO:
+            return "FILE_IO";
+        case DATATYPE:
+            return "DATATYPE";
+        case PACKED:
+            return "PACKED";
+        case BATCH:
+            return "BATCH";
         default:
             return "UNKNOWN";
     }
@@ -50,8 +77,22 @@ const char* mpi2str(mpi_t mpi_type) {
 FILE* seq_log;
 FILE* mpi_log;
 FILE* omp_log;
+FILE* typed_log;
+FILE* sparse_log;
+FILE* batch_log;
+FILE* packed_log;
+FILE* strided_log;
+
+/**
+ * @brief Open a timestamped log file named after the given tag, only rank 0 logs
+ */
+static FILE* open_log(const char* tag) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+        return NULL;
+    }
 
-FILE* init_log(impl_t impl) {
     time_t current_time;
     time(&current_time);
     
@@ -66,12 +107,20 @@ FILE* init_log(impl_t impl) {
     MPI_Comm_size(MPI_COMM_WORLD, &n_cpus);
 
     char filepath[255];
-    snprintf(filepath, 255, "../out/data/%s_%s_%d_log.csv", time_string, imp2str(impl), n_cpus);
+    snprintf(filepath, 255, "../out/data/%s_%s_%d_log.csv", time_string, tag, n_cpus);
 
     FILE* log = fopen(filepath, "w");
     if (log == NULL) {
         perror("Error opening file");
-    } else {
+    }
+
+    return log;
+}
+
+FILE* init_log(impl_t impl) {
+    FILE* log = open_log(imp2str(impl));
+    print_affinity(log);
+    if (log != NULL) {
         switch(impl){
         case SEQUENTIAL:
             fprintf(log, "Matrix Size,CPUs/Threads,Function,Implementation,Execution Time\n");
@@ -82,12 +131,64 @@ FILE* init_log(impl_t impl) {
         case OMP:
             fprintf(log, "Matrix Size,Threads,Function,Implementation,Execution Time\n");
             break;       
+        default: // OOC is logged in the OMP log
+            break;
         }
     }
         
     return log;
 }
 
+FILE* init_typed_log() {
+    FILE* log = open_log("TYPED");
+    print_affinity(log);
+    if (log != NULL) {
+        fprintf(log, "Matrix Size,CPUs/Threads,Function,Implementation,Type,Execution Time\n");
+    }
+
+    return log;
+}
+
+FILE* init_sparse_log() {
+    FILE* log = open_log("SPARSE");
+    print_affinity(log);
+    if (log != NULL) {
+        fprintf(log, "Matrix Size,CPUs/Threads,Function,Implementation,Density,Nonzeros,Execution Time\n");
+    }
+
+    return log;
+}
+
+FILE* init_batch_log() {
+    FILE* log = open_log("BATCH");
+    print_affinity(log);
+    if (log != NULL) {
+        fprintf(log, "Matrix Size,Batch,CPUs/Threads,Function,Implementation,MPI Implementation,Execution Time,Execution Time (no msg)\n");
+    }
+
+    return log;
+}
+
+FILE* init_packed_log() {
+    FILE* log = open_log("PACKED");
+    print_affinity(log);
+    if (log != NULL) {
+        fprintf(log, "Matrix Size,Threads,Function,Implementation,Execution Time\n");
+    }
+
+    return log;
+}
+
+FILE* init_strided_log() {
+    FILE* log = open_log("STRIDED");
+    print_affinity(log);
+    if (log != NULL) {
+        fprintf(log, "Matrix Size,Leading Dimension,Threads,Function,Implementation,Execution Time\n");
+    }
+
+    return log;
+}
+
 
 void print_log_seq(FILE* log, const char* msg, func_t func, impl_t imp, int size, int n_procs, double execution_time) {
 
@@ -119,6 +220,47 @@ void print_log_mpi(FILE* log, const char* msg, func_t func, impl_t imp, mpi_t mp
 }
 
 
+void print_log_typed(FILE* log, const char* msg, func_t func, impl_t imp, const char* type, int size, int n_procs, double execution_time) {
+
+    #if LOG_DEBUG == 1
+        printf("%s (%s):\n\tmatrix size: %d\n\tn_procs: %d\n\texecution time:%f\n", msg, type, size, n_procs, execution_time);
+    #endif
+
+    fprintf(log, "%d,%d,%s,%s,%s,%0.9f\n", size, n_procs, func2str(func), imp2str(imp), type, execution_time);
+}
+
+
+void print_log_sparse(FILE* log, const char* msg, func_t func, impl_t imp, int size, int n_procs, int nnz, double execution_time) {
+    double density = (double)nnz / ((double)size * size);
+
+    #if LOG_DEBUG == 1
+        printf("%s:\n\tmatrix size: %d\n\tn_procs: %d\n\tdensity: %f\n\texecution time:%f\n", msg, size, n_procs, density, execution_time);
+    #endif
+
+    fprintf(log, "%d,%d,%s,%s,%0.6f,%d,%0.9f\n", size, n_procs, func2str(func), imp2str(imp), density, nnz, execution_time);
+}
+
+
+void print_log_batch(FILE* log, const char* msg, func_t func, impl_t imp, mpi_t mpi_type, int size, int batch, int n_procs, double execution_time_tot, double execution_time_no_msg) {
+
+    #if LOG_DEBUG == 1
+        printf("%s:\n\tmatrix size: %d\n\tbatch: %d\n\tn_procs: %d\n\texecution time tot:%f\n\texecution time no msg:%f\n", msg, size, batch, n_procs, execution_time_tot, execution_time_no_msg);
+    #endif
+
+    fprintf(log, "%d,%d,%d,%s,%s,%s,%0.9f,%0.9f\n", size, batch, n_procs, func2str(func), imp2str(imp), imp == MPI ? mpi2str(mpi_type) : "NONE", execution_time_tot, execution_time_no_msg);
+}
+
+
+void print_log_strided(FILE* log, const char* msg, func_t func, impl_t imp, int size, int ld, int n_threads, double execution_time) {
+
+    #if LOG_DEBUG == 1
+        printf("%s:\n\tmatrix size: %d\n\tleading dimension: %d\n\tn_threads: %d\n\texecution time:%f\n", msg, size, ld, n_threads, execution_time);
+    #endif
+
+    fprintf(log, "%d,%d,%d,%s,%s,%0.9f\n", size, ld, n_threads, func2str(func), imp2str(imp), execution_time);
+}
+
+
 void close_log(FILE* log) {
     if(log) {
         fclose(log);
@@ -174,6 +316,12 @@ void free_mat(float* M, int rows) {
     free(M);
 }
 
+
+void get_band(int n, int rank, int n_cpus, int* count, int* offset) {
+    *count = n / n_cpus + (rank < n % n_cpus ? 1 : 0);
+    *offset = rank * (n / n_cpus) + (rank < n % n_cpus ? rank : n % n_cpus);
+}
+
 int get_num_threads() {
     const char *env_threads = getenv("OMP_NUM_THREADS");
     if(env_threads) {